@@ -0,0 +1,74 @@
+#pragma once
+
+#include "include/private/base/EgAPI.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+class EgString;
+
+/**
+ * @brief 驻留（interned）字符串的句柄
+ *
+ * 相同内容的字符串在全局表中只保存一份，EgAtom 只是指向它的指针：
+ * 比较只比指针，哈希值在驻留时算好，取用是 O(1)。驻留的字符串永不释放，
+ * 适合数量有限、反复出现的名字，例如 GLSL 标识符、uniform 名字和日志 tag。
+ * 默认构造的 EgAtom 表示空字符串，c_str() 总是有效且以 '\0' 结尾。
+ */
+class EG_API EgAtom {
+public:
+    EgAtom() : fEntry(&gEmptyEntry) {}
+
+    /**
+     * @brief 驻留 str 并返回其句柄，已存在时只做一次无锁查找
+     */
+    static EgAtom Make(const char str[]);
+    static EgAtom Make(const char str[], size_t length);
+    static EgAtom Make(std::string_view str) { return Make(str.data(), str.size()); }
+    static EgAtom Make(const EgString& str);
+
+    /**
+     * @brief 只查找不驻留，str 未被驻留过时返回 false
+     */
+    static bool Find(std::string_view str, EgAtom* atom);
+
+    const char* c_str() const { return fEntry->fData; }
+    size_t size() const { return fEntry->fLength; }
+    bool isEmpty() const { return fEntry->fLength == 0; }
+    std::string_view view() const { return {fEntry->fData, fEntry->fLength}; }
+
+    /**
+     * @brief 驻留时计算好的哈希值
+     */
+    uint32_t hash() const { return fEntry->fHash; }
+
+    friend bool operator==(EgAtom a, EgAtom b) { return a.fEntry == b.fEntry; }
+    friend bool operator!=(EgAtom a, EgAtom b) { return a.fEntry != b.fEntry; }
+
+    /**
+     * @brief 已驻留的字符串个数，用于统计
+     */
+    static size_t Count();
+
+private:
+    friend class EgAtomTable;
+
+    struct Entry {
+        uint32_t    fHash;
+        uint32_t    fLength;
+        char        fData[1];
+    };
+
+    explicit EgAtom(const Entry* entry) : fEntry(entry) {}
+
+    static const Entry gEmptyEntry;
+
+    const Entry* fEntry;
+};
+
+template <>
+struct std::hash<EgAtom> {
+    size_t operator()(EgAtom atom) const { return atom.hash(); }
+};
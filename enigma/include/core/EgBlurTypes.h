@@ -0,0 +1,10 @@
+#pragma once
+
+enum EgBlurStyle : int {
+    gNormal_EgBlurStyle,    // 内外都模糊
+    gSolid_EgBlurStyle,     // 内部保持实心，外部模糊
+    gOuter_EgBlurStyle,     // 内部为空，外部模糊
+    gInner_EgBlurStyle,     // 内部模糊，外部为空
+
+    gLastEnum_EgBlurStyle   = gInner_EgBlurStyle,
+};
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "include/private/base/EgAPI.h"
+
+#include "include/core/EgBlendMode.h"
+#include "include/core/EgColor.h"
+#include "include/core/EgRefCnt.h"
+
+/**
+ * @brief 颜色滤镜：逐像素地把一个颜色映射为另一个颜色，与像素位置无关
+ */
+class EG_API EgColorFilter : public EgRefCnt {
+public:
+    virtual ~EgColorFilter() = default;
+
+    /**
+     * @brief 滤镜是否会把完全透明的像素变为非透明
+     *
+     * 若返回 true，滤镜的输出范围不再受输入内容范围约束。
+     */
+    virtual bool affectsTransparentBlack() const = 0;
+
+protected:
+    EgColorFilter() = default;
+};
+
+namespace EgColorFilters {
+
+    /**
+     * @brief 以 color 为源、输入像素为目标，按 mode 混合
+     * @return mode 不是系数混合模式时返回 nullptr
+     */
+    EG_API EgSp<EgColorFilter> Blend(const EgColor4f& color, EgBlendMode mode);
+
+    /**
+     * @brief 4x5 颜色矩阵，作用在非预乘颜色上，结果截断到 [0, 1]
+     *
+     * 按行主序存储，每行依次为 r/g/b/a 的系数和平移量：
+     *   r' = m[0]*r + m[1]*g + m[2]*b + m[3]*a + m[4]
+     * @return 矩阵包含非有限值时返回 nullptr
+     */
+    EG_API EgSp<EgColorFilter> Matrix(const float rowMajor[20]);
+
+    static constexpr int kMaxLut3DSize = 65;
+
+    /**
+     * @brief 3D 颜色查找表，用四面体插值，作用在非预乘的 rgb 上，alpha 不变
+     * @param size 每个维度的格点数，例如 17 或 33，取值范围 [2, kMaxLut3DSize]
+     * @param table size^3 个 RGB 三元组，r 变化最快：下标为 ((b * size + g) * size + r) * 3
+     * @return 参数非法时返回 nullptr
+     */
+    EG_API EgSp<EgColorFilter> Lut3D(int size, const float* table);
+
+    /**
+     * @brief 先应用 inner 再应用 outer，两者在同一条光栅流水线中执行
+     */
+    EG_API EgSp<EgColorFilter> Compose(EgSp<EgColorFilter> outer,
+                                                  EgSp<EgColorFilter> inner);
+
+};
@@ -1,5 +1,141 @@
 #pragma once
 
-class EG_API EgColorSpace {
+#include "include/private/base/EgAPI.h"
 
-};
\ No newline at end of file
+#include "include/core/EgRefCnt.h"
+
+/**
+ * @brief 传递函数，把编码值映射为线性光
+ *
+ * gParametric 为分段参数形式（与 ICC parametric curve 相同）：
+ *   x <  d : y = c * x + f
+ *   x >= d : y = (a * x + b)^g + e
+ * gPQ / gHLG 为 HDR 曲线，参数不参与计算；线性值 1.0 对应参考白（203 nits / HLG 75% 信号）。
+ */
+struct EG_API EgTransferFunction {
+    enum Type {
+        gParametric,
+        gPQ,
+        gHLG,
+    };
+
+    Type    fType   = gParametric;
+    float   g       = 1;
+    float   a       = 1;
+    float   b       = 0;
+    float   c       = 0;
+    float   d       = 0;
+    float   e       = 0;
+    float   f       = 0;
+
+    /**
+     * @brief 计算参数形式传递函数的逆函数（线性光 -> 编码值）
+     * @return 不是参数形式或不可逆时返回 false
+     */
+    bool invert(EgTransferFunction* inverse) const;
+
+    bool operator==(const EgTransferFunction& other) const;
+    bool operator!=(const EgTransferFunction& other) const { return !(*this == other); }
+};
+
+namespace EgNamedTransferFn {
+    constexpr EgTransferFunction gSRGB      = { EgTransferFunction::gParametric,
+                                                2.4f, 1 / 1.055f, 0.055f / 1.055f, 1 / 12.92f, 0.04045f, 0, 0 };
+    constexpr EgTransferFunction g2Dot2     = { EgTransferFunction::gParametric, 2.2f, 1, 0, 0, 0, 0, 0 };
+    constexpr EgTransferFunction gLinear    = { EgTransferFunction::gParametric, 1, 1, 0, 0, 0, 0, 0 };
+    constexpr EgTransferFunction gPQ        = { EgTransferFunction::gPQ,  0, 0, 0, 0, 0, 0, 0 };
+    constexpr EgTransferFunction gHLG       = { EgTransferFunction::gHLG, 0, 0, 0, 0, 0, 0, 0 };
+};
+
+/**
+ * @brief 3x3 矩阵，行主序
+ */
+struct EG_API EgColorMatrix3x3 {
+    float vals[3][3];
+
+    bool operator==(const EgColorMatrix3x3& other) const;
+    bool operator!=(const EgColorMatrix3x3& other) const { return !(*this == other); }
+
+    /**
+     * @return 矩阵奇异时返回 false
+     */
+    bool invert(EgColorMatrix3x3* inverse) const;
+
+    /**
+     * @brief 返回 a * b
+     */
+    static EgColorMatrix3x3 Concat(const EgColorMatrix3x3& a, const EgColorMatrix3x3& b);
+};
+
+/**
+ * @brief 常用色域到 XYZ (D50) 的矩阵
+ */
+namespace EgNamedGamut {
+    constexpr EgColorMatrix3x3 gSRGB = {{
+        { 0.436065674f, 0.385147095f, 0.143066406f },
+        { 0.222488403f, 0.716873169f, 0.060607910f },
+        { 0.013916016f, 0.097076416f, 0.714096069f },
+    }};
+
+    constexpr EgColorMatrix3x3 gDisplayP3 = {{
+        {  0.515102f,   0.291965f,  0.157153f  },
+        {  0.241182f,   0.692236f,  0.0665819f },
+        { -0.00104941f, 0.0418818f, 0.784378f  },
+    }};
+
+    constexpr EgColorMatrix3x3 gRec2020 = {{
+        {  0.673459f,   0.165661f,  0.125100f  },
+        {  0.279033f,   0.675338f,  0.0456288f },
+        { -0.00193139f, 0.0299794f, 0.797162f  },
+    }};
+
+    constexpr EgColorMatrix3x3 gXYZ = {{
+        { 1, 0, 0 },
+        { 0, 1, 0 },
+        { 0, 0, 1 },
+    }};
+};
+
+/**
+ * @brief 颜色空间：传递函数 + 色域（到 XYZ D50 的矩阵）
+ *
+ * 对象创建后不可修改，可在线程间共享。
+ */
+class EG_API EgColorSpace : public EgNVRefCnt<EgColorSpace> {
+public:
+    static EgSp<EgColorSpace> MakeSRGB();
+
+    static EgSp<EgColorSpace> MakeSRGBLinear();
+
+    /**
+     * @return 传递函数参数非法或色域矩阵不可逆时返回 nullptr
+     */
+    static EgSp<EgColorSpace> MakeRGB(const EgTransferFunction& transferFn,
+                                                 const EgColorMatrix3x3& toXYZD50);
+
+    const EgTransferFunction& transferFn() const { return fTransferFn; }
+
+    /**
+     * @brief 线性光 -> 编码值的传递函数，对 PQ / HLG 与 transferFn() 相同（由 fType 区分方向）
+     */
+    const EgTransferFunction& invTransferFn() const { return fInvTransferFn; }
+
+    const EgColorMatrix3x3& toXYZD50() const { return fToXYZD50; }
+    const EgColorMatrix3x3& fromXYZD50() const { return fFromXYZD50; }
+
+    bool isSRGB() const;
+
+    bool gammaIsLinear() const;
+
+    bool isHDR() const { return fTransferFn.fType != EgTransferFunction::gParametric; }
+
+    static bool Equals(const EgColorSpace* a, const EgColorSpace* b);
+
+    EgColorSpace(const EgTransferFunction& transferFn, const EgColorMatrix3x3& toXYZD50);
+
+private:
+    EgTransferFunction  fTransferFn;
+    EgTransferFunction  fInvTransferFn;
+    EgColorMatrix3x3    fToXYZD50;
+    EgColorMatrix3x3    fFromXYZD50;
+};
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "include/private/base/EgAPI.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief 一帧的录制结果，由 EgFrameScheduler 在 UI 线程和渲染线程之间循环复用
+ *
+ * 子类保存录制下来的绘制命令（例如之后的 EgPicture），
+ * reset 在 UI 线程开始录制新一帧前调用，render 在渲染线程上执行光栅化。
+ * 同一个对象不会同时被两个线程访问。
+ */
+class EG_API EgFrameRecording {
+public:
+    virtual ~EgFrameRecording() = default;
+
+    /**
+     * @brief 清空上一帧的内容，尽量保留已分配的内存供本帧复用
+     */
+    virtual void reset() = 0;
+
+    /**
+     * @brief 光栅化录制的内容
+     */
+    virtual void render() = 0;
+};
+
+/**
+ * @brief 流水线化的帧调度：UI 线程录制第 N + 1 帧的同时，渲染线程光栅化第 N 帧
+ *
+ * 调度器持有 2 个（双缓冲）或 3 个（三缓冲）EgFrameRecording，在两个线程之间循环使用，
+ * 交接通过无锁队列完成。所有录制对象都在途时 beginFrame 阻塞，
+ * 从而限制 UI 线程最多领先渲染线程 depth - 1 帧（背压），延迟不会无限堆积。
+ * beginFrame / submitFrame 只能在同一个线程（UI 线程）上调用。
+ * 示例用法：
+ *    EgFrameScheduler scheduler(std::move(recordings));
+ *    while (running) {
+ *        EgFrameRecording* frame = scheduler.beginFrame();
+ *        recordInto(frame);
+ *        scheduler.submitFrame(frame);
+ *    }
+ */
+class EG_API EgFrameScheduler {
+public:
+    static constexpr int kMinDepth = 2;
+    static constexpr int kMaxDepth = 3;
+
+    struct Stats {
+        uint64_t    fFramesSubmitted;
+        uint64_t    fFramesRendered;
+        uint64_t    fStallNs;           // UI 线程因背压在 beginFrame 中等待的总时间
+    };
+
+    /**
+     * @param recordings 2 或 3 个录制对象，所有权转移给调度器
+     * @param threadName 渲染线程的名字
+     */
+    explicit EgFrameScheduler(std::vector<std::unique_ptr<EgFrameRecording>> recordings,
+                              const char* threadName = "EgRender");
+
+    /**
+     * @brief 渲染完所有已提交的帧后停止渲染线程
+     */
+    ~EgFrameScheduler();
+
+    EgFrameScheduler(const EgFrameScheduler&) = delete;
+    EgFrameScheduler& operator=(const EgFrameScheduler&) = delete;
+
+    int depth() const;
+
+    /**
+     * @brief 取一个空闲的录制对象并 reset，没有空闲对象时阻塞到渲染线程归还一个
+     */
+    EgFrameRecording* beginFrame();
+
+    /**
+     * @brief 不阻塞的 beginFrame，流水线已满时返回 nullptr，调用者可以跳过这一帧
+     */
+    EgFrameRecording* tryBeginFrame();
+
+    /**
+     * @brief 提交录制完成的帧，立即返回
+     */
+    void submitFrame(EgFrameRecording* frame);
+
+    /**
+     * @brief 阻塞到此前提交的帧全部渲染完成
+     */
+    void flush();
+
+    /**
+     * @brief 统计信息，在 UI 线程上调用
+     */
+    Stats stats() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> fImpl;
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "include/private/base/EgAPI.h"
+#include "include/core/EgBlendMode.h"
+
+#include <cstdint>
+
+/**
+ * @brief 统计中区分的绘制类型
+ */
+enum EgDrawType {
+    gMaskFilter_EgDrawType,         // 对光栅化后的遮罩做滤镜（模糊等）
+    gRRectMaskFilter_EgDrawType,    // 由圆角矩形几何解析生成滤镜遮罩
+    gImageFilterLayer_EgDrawType,   // 对图层执行图像滤镜 DAG
+    gLastEnum_EgDrawType            = gImageFilterLayer_EgDrawType,
+};
+
+/**
+ * 渲染统计
+ *
+ * 计数器是进程级的 relaxed 原子变量，记录本身不加锁也不影响绘制的内存顺序。
+ * 每帧结束时调用 EndFrame 取出本帧的数据并清零，导出到监控系统用于发现性能退化。
+ */
+struct EG_API EgFrameStats {
+    uint64_t    fDraws[gLastEnum_EgDrawType + 1]    = {};
+    uint64_t    fPixelsBlended[gEgBlendModeCount]  = {};   // 按混合模式统计参与混合的像素数
+    uint64_t    fPipelinesBuilt                     = 0;    // 光栅流水线解析阶段表的次数
+    uint64_t    fCacheHits                          = 0;    // 图像滤镜 DAG 的结果缓存命中
+    uint64_t    fCacheMisses                        = 0;
+    uint64_t    fBytesAllocated                     = 0;    // 遮罩与中间图像分配的像素内存
+
+    uint64_t totalDraws() const;
+
+    /**
+     * @brief 缓存命中率，没有查询时返回 0
+     */
+    double cacheHitRate() const;
+
+    /**
+     * @brief 读取当前帧到目前为止的统计，不清零
+     */
+    static EgFrameStats Peek();
+
+    /**
+     * @brief 取出当前帧的统计并清零，开始统计下一帧
+     *
+     * 与其他线程的记录并发时，每个计数器单独原子地交换，跨计数器的数据不保证出自同一时刻。
+     */
+    static EgFrameStats EndFrame();
+};
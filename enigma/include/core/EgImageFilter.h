@@ -0,0 +1,51 @@
+#pragma once
+
+#include "include/private/base/EgAPI.h"
+#include "include/private/base/EgAssert.h"
+
+#include "include/core/EgRect.h"
+#include "include/core/EgRefCnt.h"
+
+#include <vector>
+
+/**
+ * @brief 图像滤镜：作用在整个图层上的像素变换
+ *
+ * 每个滤镜有若干输入，输入为 nullptr 表示直接使用图层的源图像。
+ * 同一个滤镜可以被多个滤镜引用，因此滤镜之间构成一张有向无环图（DAG）。
+ */
+class EG_API EgImageFilter : public EgRefCnt {
+public:
+    enum MapDirection {
+        gForward_MapDirection,  // 由输入内容范围推导输出内容范围
+        gReverse_MapDirection,  // 由期望的输出范围推导所需的输入范围
+    };
+
+    virtual ~EgImageFilter() = default;
+
+    /**
+     * @brief 把 src 沿 direction 映射经过整张滤镜图
+     *
+     * - gForward_MapDirection : src 为源图像的内容范围，返回滤镜输出可能非透明的范围
+     * - gReverse_MapDirection : src 为期望的输出范围，返回计算它所需的源图像范围
+     */
+    EgIRect filterBounds(const EgIRect& src, MapDirection direction) const;
+
+    int countInputs() const { return (int)fInputs.size(); }
+
+    const EgImageFilter* getInput(int index) const {
+        EgAssert(index >= 0 && index < this->countInputs());
+        return fInputs[index].get();
+    }
+
+    EgSp<EgImageFilter> refInput(int index) const {
+        EgAssert(index >= 0 && index < this->countInputs());
+        return fInputs[index];
+    }
+
+protected:
+    explicit EgImageFilter(std::vector<EgSp<EgImageFilter>> inputs)
+        : fInputs(std::move(inputs)) {}
+
+    std::vector<EgSp<EgImageFilter>> fInputs;
+};
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "include/private/base/EgAPI.h"
+
+#include "include/core/EgBlurTypes.h"
+#include "include/core/EgRect.h"
+#include "include/core/EgRefCnt.h"
+#include "include/core/EgScalar.h"
+
+/**
+ * @brief 遮罩滤镜：在图形被光栅化为覆盖率遮罩之后、与目标混合之前，对遮罩做变换
+ */
+class EG_API EgMaskFilter : public EgRefCnt {
+public:
+    virtual ~EgMaskFilter() = default;
+
+    /**
+     * @brief 创建高斯模糊遮罩滤镜
+     * @param style 模糊样式
+     * @param sigma 高斯分布的标准差，必须 > 0
+     * @return sigma 非法时返回 nullptr
+     */
+    static EgSp<EgMaskFilter> MakeBlur(EgBlurStyle style, EgScalar sigma);
+
+    /**
+     * @brief 返回对 src 区域应用滤镜后可能影响到的区域
+     */
+    virtual EgRect approximateFilteredBounds(const EgRect& src) const = 0;
+
+protected:
+    EgMaskFilter() = default;
+};
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "include/private/base/EgAPI.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+
+/**
+ * @brief 内存统计按子系统划分
+ */
+enum EgMemorySubsystem {
+    gStrings_EgMemorySubsystem,
+    gPaths_EgMemorySubsystem,
+    gPixels_EgMemorySubsystem,      // 遮罩、中间图像等像素缓冲
+    gCaches_EgMemorySubsystem,
+    gPictureOps_EgMemorySubsystem,
+    gOther_EgMemorySubsystem,
+    gLastEnum_EgMemorySubsystem     = gOther_EgMemorySubsystem,
+};
+
+/**
+ * 带子系统标记的内存分配
+ *
+ * 接口与 malloc / calloc / realloc / free 对应，按分配器实际给出的块大小（malloc_usable_size）
+ * 记录每个子系统的当前占用和峰值，计数器都是 relaxed 原子变量。
+ * 设置了全局预算后，分配使总占用超过预算时只做标记，之后在安全点（PurgeIfOverBudget，
+ * 例如 EgFrameScheduler 每帧开始时）依次调用已注册的清理回调，直到回到预算以内。
+ * 超出预算不会让分配失败，预算只是触发清理的阈值。
+ */
+namespace EgMemory {
+
+    struct Usage {
+        size_t  fCurrent;
+        size_t  fPeak;
+    };
+
+    EG_API void* Malloc(EgMemorySubsystem subsystem, size_t size);
+
+    EG_API void* Calloc(EgMemorySubsystem subsystem, size_t size);
+
+    EG_API void* Realloc(EgMemorySubsystem subsystem, void* ptr, size_t size);
+
+    /**
+     * @brief 释放 Malloc / Calloc / Realloc 分配的内存，subsystem 必须与分配时一致
+     */
+    EG_API void Free(EgMemorySubsystem subsystem, void* ptr);
+
+    EG_API Usage GetUsage(EgMemorySubsystem subsystem);
+
+    /**
+     * @brief 所有子系统的当前占用之和
+     */
+    EG_API size_t TotalBytes();
+
+    /**
+     * @brief 把各子系统的峰值重置为当前占用
+     */
+    EG_API void ResetPeaks();
+
+    /**
+     * @brief 设置全局预算，0 表示不限制
+     */
+    EG_API void SetBudget(size_t bytes);
+
+    EG_API size_t GetBudget();
+
+    /**
+     * @brief 清理回调：尽量释放至少 bytesToFree 字节，返回实际释放的字节数
+     *
+     * 回调在调用 PurgeTo / PurgeIfOverBudget 的线程上执行，不在分配路径上执行。
+     */
+    using PurgeCallback = std::function<size_t(size_t bytesToFree)>;
+
+    /**
+     * @brief 注册清理回调，返回用于注销的 ID
+     */
+    EG_API int RegisterPurgeCallback(PurgeCallback callback);
+
+    EG_API void UnregisterPurgeCallback(int id);
+
+    /**
+     * @brief 立即清理，使总占用不超过 targetBytes；其他线程正在清理时直接返回 0
+     * @return 回调释放的字节数
+     */
+    EG_API size_t PurgeTo(size_t targetBytes);
+
+    /**
+     * @brief 安全点：之前有分配超出预算时执行一次清理
+     *
+     * 调用时不应持有任何可能在清理回调里获取的锁。
+     * @return 回调释放的字节数
+     */
+    EG_API size_t PurgeIfOverBudget();
+
+};
+
+/**
+ * @brief 把标准容器的分配记到指定子系统上
+ * 示例用法：
+ *    std::vector<float, EgMemoryAllocator<float, gCaches_EgMemorySubsystem>> entries;
+ */
+template <typename T, EgMemorySubsystem kSubsystem>
+class EgMemoryAllocator {
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = EgMemoryAllocator<U, kSubsystem>;
+    };
+
+    EgMemoryAllocator() = default;
+
+    template <typename U>
+    EgMemoryAllocator(const EgMemoryAllocator<U, kSubsystem>&) {}
+
+    T* allocate(size_t count) {
+        void* memory = EgMemory::Malloc(kSubsystem, count * sizeof(T));
+        if (memory == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(memory);
+    }
+
+    void deallocate(T* ptr, size_t) {
+        EgMemory::Free(kSubsystem, ptr);
+    }
+
+    template <typename U>
+    bool operator==(const EgMemoryAllocator<U, kSubsystem>&) const { return true; }
+};
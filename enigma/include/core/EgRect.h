@@ -640,7 +640,7 @@ public:
             fRight >= EgIntToScalar(r.fRight) && fBottom >= EgIntToScalar(r.fBottom);
     }
 
-    void round(EgIRect* dst) {
+    void round(EgIRect* dst) const {
         EgAssert(dst);
         dst->setLTRB(
             EgScalarRoundToInt(fLeft), EgScalarRoundToInt(fTop),
@@ -648,7 +648,7 @@ public:
         );
     }
 
-    void roundOut(EgIRect* dst) {
+    void roundOut(EgIRect* dst) const {
         EgAssert(dst);
         dst->setLTRB(
             EgScalarFloorToInt(fLeft), EgScalarFloorToInt(fTop),
@@ -656,7 +656,7 @@ public:
         );
     }
 
-    void roundOut(EgRect* dst) {
+    void roundOut(EgRect* dst) const {
         EgAssert(dst);
         dst->setLTRB(
             EgScalarFloorToScalar(fLeft), EgScalarFloorToScalar(fTop),
@@ -664,7 +664,7 @@ public:
         );
     }
 
-    void roundIn(EgIRect* dst) {
+    void roundIn(EgIRect* dst) const {
         EgAssert(dst);
         dst->setLTRB(
             EgScalarCeilToInt(fLeft), EgScalarCeilToInt(fTop),
@@ -0,0 +1,256 @@
+#pragma once
+
+#include "include/private/base/EgAPI.h"
+#include "include/private/base/EgAssert.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief 侵入式引用计数基类
+ *
+ * 新建对象的引用计数为 1，由第一个 EgSp 接管（EgMakeSp / EgSp(T*)）。
+ * 计数归零时通过虚析构函数 delete 自身，因此不需要额外的控制块。
+ */
+class EG_API EgRefCntBase {
+public:
+    EgRefCntBase() : fRefCnt(1) {}
+
+    virtual ~EgRefCntBase() {
+#if defined(EG_DEBUG) && EG_DEBUG
+        EgAssert(this->getRefCnt() == 1);
+        fRefCnt.store(0, std::memory_order_relaxed);
+#endif
+    }
+
+    EgRefCntBase(const EgRefCntBase&) = delete;
+    EgRefCntBase& operator=(const EgRefCntBase&) = delete;
+
+    /**
+     * @brief 是否只有一个持有者，为 true 时可以安全地原地修改对象
+     */
+    bool unique() const {
+        // acquire 与其它线程 unref 的 release 配对，保证它们的写入对当前线程可见
+        return fRefCnt.load(std::memory_order_acquire) == 1;
+    }
+
+    void ref() const {
+        EgAssert(this->getRefCnt() > 0);
+        // 增加计数不需要同步：调用者本身已持有一个引用
+        (void)fRefCnt.fetch_add(+1, std::memory_order_relaxed);
+    }
+
+    void unref() const {
+        EgAssert(this->getRefCnt() > 0);
+        if (1 == fRefCnt.fetch_add(-1, std::memory_order_acq_rel)) {
+#if defined(EG_DEBUG) && EG_DEBUG
+            // 析构函数断言计数为 1
+            fRefCnt.store(1, std::memory_order_relaxed);
+#endif
+            delete this;
+        }
+    }
+
+private:
+    int32_t getRefCnt() const { return fRefCnt.load(std::memory_order_relaxed); }
+
+    mutable std::atomic<int32_t> fRefCnt;
+};
+
+class EG_API EgRefCnt : public EgRefCntBase {};
+
+/**
+ * @brief 不带虚函数的引用计数基类，适用于没有虚表的具体类型
+ *
+ * 计数归零时以 Derived 类型 delete，省去虚析构的开销。
+ */
+template <typename Derived>
+class EgNVRefCnt {
+public:
+    EgNVRefCnt() : fRefCnt(1) {}
+    ~EgNVRefCnt() {
+#if defined(EG_DEBUG) && EG_DEBUG
+        EgAssert(fRefCnt.load(std::memory_order_relaxed) == 1);
+#endif
+    }
+
+    EgNVRefCnt(const EgNVRefCnt&) = delete;
+    EgNVRefCnt& operator=(const EgNVRefCnt&) = delete;
+
+    bool unique() const { return fRefCnt.load(std::memory_order_acquire) == 1; }
+
+    void ref() const { (void)fRefCnt.fetch_add(+1, std::memory_order_relaxed); }
+
+    void unref() const {
+        if (1 == fRefCnt.fetch_add(-1, std::memory_order_acq_rel)) {
+#if defined(EG_DEBUG) && EG_DEBUG
+            fRefCnt.store(1, std::memory_order_relaxed);
+#endif
+            delete (const Derived*)this;
+        }
+    }
+
+private:
+    mutable std::atomic<int32_t> fRefCnt;
+};
+
+/**
+ * @brief obj 非空时增加引用计数，返回 obj 本身
+ */
+template <typename T>
+static inline T* EgSafeRef(T* obj) {
+    if (obj) {
+        obj->ref();
+    }
+    return obj;
+}
+
+/**
+ * @brief obj 非空时减少引用计数
+ */
+template <typename T>
+static inline void EgSafeUnref(T* obj) {
+    if (obj) {
+        obj->unref();
+    }
+}
+
+/**
+ * @brief 侵入式引用计数智能指针
+ *
+ * 与 std::shared_ptr 的区别：计数保存在对象内部，EgSp 只有一个指针大小，
+ * 拷贝只做一次原子加，移动不触碰计数。
+ * EgSp(T*) 接管调用者持有的那个引用，不会额外 ref。
+ */
+template <typename T>
+class EgSp {
+public:
+    using element_type = T;
+
+    constexpr EgSp() : fPtr(nullptr) {}
+    constexpr EgSp(std::nullptr_t) : fPtr(nullptr) {}
+
+    EgSp(const EgSp<T>& that) : fPtr(EgSafeRef(that.get())) {}
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+    EgSp(const EgSp<U>& that) : fPtr(EgSafeRef(that.get())) {}
+
+    EgSp(EgSp<T>&& that) noexcept : fPtr(that.release()) {}
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+    EgSp(EgSp<U>&& that) noexcept : fPtr(that.release()) {}
+
+    /**
+     * @brief 接管 obj 的一个引用
+     */
+    explicit EgSp(T* obj) : fPtr(obj) {}
+
+    ~EgSp() {
+        EgSafeUnref(fPtr);
+    }
+
+    EgSp<T>& operator=(std::nullptr_t) {
+        this->reset();
+        return *this;
+    }
+
+    EgSp<T>& operator=(const EgSp<T>& that) {
+        if (this != &that) {
+            this->reset(EgSafeRef(that.get()));
+        }
+        return *this;
+    }
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+    EgSp<T>& operator=(const EgSp<U>& that) {
+        this->reset(EgSafeRef(that.get()));
+        return *this;
+    }
+
+    EgSp<T>& operator=(EgSp<T>&& that) noexcept {
+        this->reset(that.release());
+        return *this;
+    }
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+    EgSp<T>& operator=(EgSp<U>&& that) noexcept {
+        this->reset(that.release());
+        return *this;
+    }
+
+    T& operator*() const {
+        EgAssert(this->get() != nullptr);
+        return *this->get();
+    }
+
+    T* operator->() const { return fPtr; }
+
+    explicit operator bool() const { return this->get() != nullptr; }
+
+    T* get() const { return fPtr; }
+
+    /**
+     * @brief 换成 ptr（接管其引用），旧对象在赋值之后才 unref，
+     * 以免析构过程中再次访问到本 EgSp。
+     */
+    void reset(T* ptr = nullptr) {
+        T* oldPtr = fPtr;
+        fPtr = ptr;
+        EgSafeUnref(oldPtr);
+    }
+
+    /**
+     * @brief 放弃所有权并返回裸指针，调用者负责之后的 unref
+     */
+    [[nodiscard]] T* release() {
+        T* ptr = fPtr;
+        fPtr = nullptr;
+        return ptr;
+    }
+
+    void swap(EgSp<T>& that) {
+        using std::swap;
+        swap(fPtr, that.fPtr);
+    }
+
+private:
+    T* fPtr;
+};
+
+template <typename T>
+inline void swap(EgSp<T>& a, EgSp<T>& b) {
+    a.swap(b);
+}
+
+template <typename T, typename U>
+inline bool operator==(const EgSp<T>& a, const EgSp<U>& b) {
+    return a.get() == b.get();
+}
+template <typename T>
+inline bool operator==(const EgSp<T>& a, std::nullptr_t) {
+    return !a;
+}
+
+template <typename T, typename U>
+inline bool operator!=(const EgSp<T>& a, const EgSp<U>& b) {
+    return a.get() != b.get();
+}
+template <typename T>
+inline bool operator!=(const EgSp<T>& a, std::nullptr_t) {
+    return static_cast<bool>(a);
+}
+
+/**
+ * @brief 构造 T 并用 EgSp 接管，相当于 std::make_shared，但没有控制块
+ */
+template <typename T, typename... Args>
+EgSp<T> EgMakeSp(Args&&... args) {
+    return EgSp<T>(new T(std::forward<Args>(args)...));
+}
+
+/**
+ * @brief 为裸指针增加一个引用并包装成 EgSp
+ */
+template <typename T>
+EgSp<T> EgRef(T* obj) {
+    return EgSp<T>(EgSafeRef(obj));
+}
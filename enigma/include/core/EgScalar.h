@@ -65,6 +65,16 @@ static inline bool EgScalarIsNaN(EgScalar v) {
     return eg_float_isnan(v);
 }
 
+static inline bool EgScalarsAreFinite(const EgScalar array[], int count) {
+    EgAssert(count >= 0);
+    EgScalar prod = 0;
+    for (int i = 0; i < count; ++i) {
+        prod *= array[i];
+    }
+    // 0 * 有限值 = 0，0 * inf 或 0 * NaN = NaN
+    return prod == 0;
+}
+
 static inline EgScalar EgScalarSquare(EgScalar v) {
     return v * v;
 }
@@ -2,7 +2,9 @@
 
 #include "include/private/base/EgAPI.h"
 
-class EG_API EgShader {
+#include "include/core/EgRefCnt.h"
+
+class EG_API EgShader : public EgRefCnt {
 
 public:
     virtual bool isOpaque() const { return false; }
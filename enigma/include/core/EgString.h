@@ -11,7 +11,7 @@
 #include <cstdint>
 #include <cstddef>
 #include <atomic>
-#include <memory>
+#include <cstring>
 
 /**
  * @brief 检查字符串是否以指定前缀开头
@@ -69,8 +69,33 @@ static inline bool EgStrContains(const char str[], const char substr[]) {
 }
 
 static inline bool EgStrContains(const char str[], const char substrChar) {
-    char temp[2] = {substrChar, '\0'};
-    return EgStrContains(str, temp);
+    // strchr 查找 '\0' 时返回结尾处，与查找空串的 strstr 一样视为包含
+    return strchr(str, substrChar) != nullptr;
+}
+
+/**
+ * @brief 已知长度的子串查找，不再扫描 '\0' 求长度
+ * @return 子串第一次出现的位置，找不到时返回 -1；substrLen 为 0 时返回 0
+ * @note 单字节用 memchr，短子串按首尾字节做 SIMD 过滤，长子串用 Two-Way 算法（最坏线性时间）
+ */
+int EgStrFind(const char str[], size_t strLen, const char substr[], size_t substrLen);
+
+static inline bool EgStrContains(const char str[], size_t strLen, const char substr[], size_t substrLen) {
+    return EgStrFind(str, strLen, substr, substrLen) != -1;
+}
+
+/**
+ * @brief 已知长度的后缀判断
+ */
+static inline bool EgStrEndsWith(const char str[], size_t strLen, const char suffix[], size_t suffixLen) {
+    return strLen >= suffixLen && !memcmp(str + strLen - suffixLen, suffix, suffixLen);
+}
+
+/**
+ * @brief 已知长度的前缀判断
+ */
+static inline bool EgStrStartsWith(const char str[], size_t strLen, const char prefix[], size_t prefixLen) {
+    return strLen >= prefixLen && !memcmp(str, prefix, prefixLen);
 }
 
 static constexpr int kEgStrAppendU32_MaxSize = 10;
@@ -102,10 +127,13 @@ public:
     explicit    EgString(std::string_view str);
                 ~EgString();
 
-    bool isEmpty() const { return mRec->mLength == 0; }
-    size_t size() const { return (size_t)(mRec->mLength); }
-    const char* c_str() const { return mRec->data(); }
-    const char* data() const { return mRec->data(); }
+    bool isEmpty() const { return this->size() == 0; }
+    size_t size() const {
+        return this->isHeap() ? (size_t)this->heapRec()->mLength
+                              : kInlineCapacity - (uint8_t)mStorage[kInlineCapacity];
+    }
+    const char* c_str() const { return this->isHeap() ? this->heapRec()->data() : mStorage; }
+    const char* data() const { return this->c_str(); }
     
     char operator[](size_t index) const { return data()[index]; }
 
@@ -114,35 +142,52 @@ public:
     bool equals(const char str[], size_t len) const;
 
     bool startsWith(const char prefix[]) const {
-        return EgStrStartsWith(mRec->data(), prefix);
+        return EgStrStartsWith(this->c_str(), prefix);
     }
 
     bool startsWith(const char prefixChar) const {
-        return EgStrStartsWith(mRec->data(), prefixChar);
+        return EgStrStartsWith(this->c_str(), prefixChar);
+    }
+
+    bool startsWith(const EgString& prefix) const {
+        return EgStrStartsWith(this->c_str(), this->size(), prefix.c_str(), prefix.size());
     }
 
     bool endsWith(const char suffix[]) const {
-        return EgStrEndsWith(mRec->data(), suffix);
+        return EgStrEndsWith(this->c_str(), this->size(), suffix, strlen(suffix));
     }
 
     bool endsWith(const char suffixChar) const {
-        return EgStrEndsWith(mRec->data(), suffixChar);
+        return this->size() > 0 && this->c_str()[this->size() - 1] == suffixChar;
+    }
+
+    bool endsWith(const EgString& suffix) const {
+        return EgStrEndsWith(this->c_str(), this->size(), suffix.c_str(), suffix.size());
     }
 
     bool contains(const char substr[]) const {
-        return EgStrContains(mRec->data(), substr);
+        return this->find(substr) != -1;
     }
 
     bool contains(const char substrChar) const {
-        return EgStrContains(mRec->data(), substrChar);
+        // 包含结尾的 '\0'，与 C 字符串版本的语义一致
+        return memchr(this->c_str(), substrChar, this->size() + 1) != nullptr;
+    }
+
+    bool contains(const EgString& substr) const {
+        return this->find(substr) != -1;
     }
 
     int find(const char substr[]) const {
-        return EgStrFind(mRec->data(), substr);
+        return EgStrFind(this->c_str(), this->size(), substr, strlen(substr));
+    }
+
+    int find(const EgString& substr) const {
+        return EgStrFind(this->c_str(), this->size(), substr.c_str(), substr.size());
     }
 
     int findLastOf(const char subchar) const {
-        return EgStrFindLastOf(mRec->data(), subchar);
+        return EgStrFindLastOf(this->c_str(), subchar);
     }
 
     friend bool operator==(const EgString& lhs, const EgString& rhs) {
@@ -163,6 +208,24 @@ public:
     void reset();
     void resize(size_t len);
 
+    /**
+     * @brief 不重新分配内存即可容纳的字符数（不含结尾的 '\0'）
+     */
+    size_t capacity() const { return this->isHeap() ? this->heapRec()->mCapacity : kInlineCapacity; }
+
+    /**
+     * @brief 预留至少 capacity 个字符的独占空间，之后长度不超过它的修改都不会重新分配
+     */
+    void reserve(size_t capacity);
+
+    /**
+     * @brief 在末尾增加 len 个未初始化的字符，返回新增部分的起始地址
+     *
+     * 空间不足时按 1.5 倍增长，连续追加的均摊开销为常数。调用者可以先多增加一些，
+     * 写完后再用 resize 截到实际长度。
+     */
+    char* growBy(size_t len);
+
     void set(const EgString& src) { *this = src; }
     void set(const char str[]);
     void set(const char str[], size_t len);
@@ -207,6 +270,13 @@ public:
     void printf(const char fmt[], ...);
     void printfVAList(const char fmt[], va_list args);
 
+    /**
+     * @brief 格式化后追加到末尾，直接写入剩余容量，不经过中间缓冲区
+     * @note 参数不能引用本字符串自身的内容
+     */
+    void appendf(const char fmt[], ...);
+    void appendVAList(const char fmt[], va_list args);
+
     void remove(size_t offset, size_t len);
 
     EgString& operator+=(const char str[]) { this->append(str); return *this; }
@@ -215,30 +285,63 @@ public:
 
     void swap(EgString& other);
 private:
+    /**
+     * 堆上字符串的头部，数据紧跟其后，引用计数是侵入式的，拷贝 EgString 只增加计数。
+     */
     struct Rec {
         public:
-            constexpr Rec(uint32_t len, uint32_t refCnt): mLength(len), mRefCnt(refCnt) {}
+            constexpr Rec(uint32_t len, uint32_t capacity, uint32_t refCnt)
+                : mLength(len), mCapacity(capacity), mRefCnt(refCnt) {}
 
-            static std::shared_ptr<Rec> Make(const char str[], size_t len);
-            static std::shared_ptr<Rec> MakeEmpty();
+            /**
+             * @param capacity 至少能容纳的字符数（不含结尾的 '\0'），不小于 len
+             */
+            static Rec* Make(const char str[], size_t len, size_t capacity);
             char* data() { return mBeginningOfData; }
             const char* data() const { return mBeginningOfData; }
             void ref() const;
             void unref() const;
             bool unique() const;
 
+            // 数据成员的访问权限保持一致，Rec 才是标准布局，可以用 offsetof 计算头部大小
             uint32_t mLength;
-        private:
+            uint32_t mCapacity;
             mutable std::atomic<uint32_t> mRefCnt;
             char mBeginningOfData[1] = { '\0' };
-
-            void operator delete(void* ptr) {
-                ::operator delete(ptr);
-            }
     };
 
+    /**
+     * 存储布局（24 字节）：
+     * - 短字符串：mStorage[0, len) 为内容，mStorage[kInlineCapacity] 存放 kInlineCapacity - len。
+     *   长度恰好为 kInlineCapacity 时该字节为 0，同时充当结尾的 '\0'。
+     * - 堆字符串：mStorage 开头存放 Rec*，mStorage[kInlineCapacity] 为 kHeapTag。
+     * 默认构造的空字符串就是长度为 0 的短字符串，不会分配内存。
+     */
+    static constexpr size_t kInlineCapacity = 23;
+    static constexpr uint8_t kHeapTag = 0xFF;
+
+    bool isHeap() const { return (uint8_t)mStorage[kInlineCapacity] == kHeapTag; }
+    Rec* heapRec() const {
+        Rec* rec;
+        memcpy(&rec, mStorage, sizeof(rec));
+        return rec;
+    }
+    void setHeapRec(Rec* rec) {
+        memcpy(mStorage, &rec, sizeof(rec));
+        mStorage[kInlineCapacity] = (char)kHeapTag;
+    }
+    void setInlineLength(size_t len) {
+        EgAssert(len <= kInlineCapacity);
+        mStorage[len] = '\0';
+        mStorage[kInlineCapacity] = (char)(kInlineCapacity - len);
+    }
+
+    void initWith(const char str[], size_t len);
+    void release();
+    bool canWriteInPlace(size_t len) const;
+    void setLengthInPlace(size_t len);
+
     const EgString& validate() const { return *this; }
 
-    std::shared_ptr<Rec> mRec;
-    static const Rec kEmptyRec;
-};
\ No newline at end of file
+    alignas(void*) char mStorage[kInlineCapacity + 1];
+};
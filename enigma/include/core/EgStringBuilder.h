@@ -0,0 +1,78 @@
+#pragma once
+
+#include "include/core/EgString.h"
+
+#include <cstdarg>
+#include <string_view>
+#include <utility>
+
+/**
+ * @brief 拼接字符串用的构建器
+ *
+ * 内部持有一个独占的 EgString，容量与长度分开记录，追加时按 1.5 倍增长，
+ * 大量小片段拼接（例如生成着色器源码）的均摊开销为常数。
+ * 拼接完成后用 detach() 取出结果，不会再拷贝一次。
+ */
+class EgStringBuilder {
+public:
+    EgStringBuilder() = default;
+    explicit EgStringBuilder(size_t capacity) { fString.reserve(capacity); }
+
+    EgStringBuilder(const EgStringBuilder&) = delete;
+    EgStringBuilder& operator=(const EgStringBuilder&) = delete;
+
+    bool isEmpty() const { return fString.isEmpty(); }
+    size_t size() const { return fString.size(); }
+    size_t capacity() const { return fString.capacity(); }
+    const char* c_str() const { return fString.c_str(); }
+    std::string_view view() const { return {fString.c_str(), fString.size()}; }
+
+    void reserve(size_t capacity) { fString.reserve(capacity); }
+
+    /**
+     * @brief 清空内容，释放缓冲区
+     */
+    void reset() { fString.reset(); }
+
+    /**
+     * @brief 取出拼接结果，构建器恢复为空
+     */
+    EgString detach() { return std::move(fString); }
+
+    /**
+     * @brief 在末尾增加 len 个未初始化的字符，返回其起始地址，见 EgString::growBy
+     */
+    char* growBy(size_t len) { return fString.growBy(len); }
+
+    EgStringBuilder& append(const char str[]) { fString.append(str); return *this; }
+    EgStringBuilder& append(const char str[], size_t len) { fString.append(str, len); return *this; }
+    EgStringBuilder& append(const EgString& str) { fString.append(str); return *this; }
+    EgStringBuilder& append(std::string_view str) { fString.append(str); return *this; }
+    EgStringBuilder& append(char c) { *fString.growBy(1) = c; return *this; }
+    EgStringBuilder& appendUnichar(char unichar) { fString.appendUnichar(unichar); return *this; }
+    EgStringBuilder& appendS32(int32_t value) { fString.appendS32(value); return *this; }
+    EgStringBuilder& appendS64(int64_t value, int minDigits = 0) { fString.appendS64(value, minDigits); return *this; }
+    EgStringBuilder& appendU32(uint32_t value) { fString.appendU32(value); return *this; }
+    EgStringBuilder& appendU64(uint64_t value, int minDigits = 0) { fString.appendU64(value, minDigits); return *this; }
+    EgStringBuilder& appendScalar(EgScalar value) { fString.appendScalar(value); return *this; }
+    EgStringBuilder& appendHex(uint32_t value, int minDigits = 0) { fString.appendHex(value, minDigits); return *this; }
+
+    /**
+     * @note 参数不能引用构建器自身的内容
+     */
+    EgStringBuilder& appendf(const char fmt[], ...) {
+        va_list args;
+        va_start(args, fmt);
+        fString.appendVAList(fmt, args);
+        va_end(args);
+        return *this;
+    }
+
+    EgStringBuilder& appendVAList(const char fmt[], va_list args) {
+        fString.appendVAList(fmt, args);
+        return *this;
+    }
+
+private:
+    EgString fString;
+};
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "include/private/base/EgAPI.h"
+
+#include "include/core/EgBlendMode.h"
+#include "include/core/EgColorFilter.h"
+#include "include/core/EgImageFilter.h"
+#include "include/core/EgRect.h"
+#include "include/core/EgScalar.h"
+
+#include <vector>
+
+/**
+ * @brief 图像滤镜的工厂函数
+ *
+ * 所有 input 参数为 nullptr 时表示使用图层的源图像。参数非法时返回 nullptr。
+ */
+namespace EgImageFilters {
+
+    /**
+     * @brief 高斯模糊，sigma 为 0 的方向不做模糊
+     */
+    EG_API EgSp<EgImageFilter> Blur(EgScalar sigmaX, EgScalar sigmaY,
+                                               EgSp<EgImageFilter> input = nullptr);
+
+    /**
+     * @brief 把输入平移 (dx, dy) 个像素
+     */
+    EG_API EgSp<EgImageFilter> Offset(int dx, int dy,
+                                                 EgSp<EgImageFilter> input = nullptr);
+
+    /**
+     * @brief 对输入应用颜色滤镜
+     */
+    EG_API EgSp<EgImageFilter> ColorFilter(EgSp<EgColorFilter> cf,
+                                                      EgSp<EgImageFilter> input = nullptr);
+
+    /**
+     * @brief 按顺序以 SrcOver 叠加所有输入
+     */
+    EG_API EgSp<EgImageFilter> Merge(std::vector<EgSp<EgImageFilter>> inputs);
+
+    /**
+     * @brief 以 foreground 为源、background 为目标按 mode 混合，只支持系数混合模式
+     */
+    EG_API EgSp<EgImageFilter> Blend(EgBlendMode mode,
+                                                EgSp<EgImageFilter> background,
+                                                EgSp<EgImageFilter> foreground = nullptr);
+
+    /**
+     * @brief 把输入裁剪到 rect（按像素取整），rect 之外为透明
+     */
+    EG_API EgSp<EgImageFilter> Crop(const EgRect& rect,
+                                               EgSp<EgImageFilter> input = nullptr);
+
+};
@@ -4,6 +4,16 @@
     #define EG_IMPLEMENTATION 0
 #endif
 
+// 调试开关，所有依赖它的头文件（EgAssert、EgRefCnt 等）都经由本文件取得同一个默认值，
+// 以免同一个 inline 函数在不同编译单元里展开成不同的定义
+#if !defined(EG_DEBUG)
+    #if defined(NDEBUG)
+        #define EG_DEBUG 0
+    #else
+        #define EG_DEBUG 1
+    #endif
+#endif
+
 #if !defined(EG_API)
     #if defined(_MSC_VER)
         #if EG_IMPLEMENTATION
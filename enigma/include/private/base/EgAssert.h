@@ -1,6 +1,9 @@
 #pragma once
 
+#include "include/private/base/EgAPI.h"
+
 #include <cstdio>
+#include <cstdlib>
 
 #ifndef EG_ABORT
     #define EG_DUMP_LINE_FORMAT "%s(%d)"
@@ -15,7 +18,7 @@
 #define EgAssertRelease(cond) \
     static_cast<void>( (cond) ? (void)0 : [] { EG_ABORT("assert(%s)", #cond); }() )
 
-#if defined(EG_DEBUG)
+#if defined(EG_DEBUG) && EG_DEBUG
     #define EgAssert(cond) EgAssertRelease(cond)
     #define EgAssertf(cond, fmt, ...) EgAssertRelease((cond) ? true : (EG_ABORT(fmt, ##__VA_ARGS__), false))
     #define EgDebugFail(message) EG_ABORT(message)
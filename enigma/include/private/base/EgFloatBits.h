@@ -48,7 +48,7 @@ constexpr int32_t gFloatBits_matissa_mask   = 0x007FFFFF;
  * 如果不是全1，则表示这是一个有限数。
  */
 static inline bool EgFloatBits_IsFinite(int32_t bits) {
-    return (bits & gFloatBits_exponent_mask) != gFloatBits_matissa_mask;
+    return (bits & gFloatBits_exponent_mask) != gFloatBits_exponent_mask;
 }
 
 /**
@@ -192,7 +192,7 @@ static inline bool eg_float_isnan(float x) {
  * 该函数用于判断给定的浮点数 x 是否为有限数，即不是无穷大也不是 NaN。
  */
 static inline bool eg_float_isfinite(float x) {
-    return EgFloatBits_IsFinite(x);
+    return EgFloatBits_IsFinite(EgFloat2Bits(x));
 }
 
 #define EG_MAXS32FitsInFloat        2147483520
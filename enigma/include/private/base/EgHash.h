@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief 64 位乘法混合：a * b 的 128 位结果高低两半异或
+ */
+static inline uint64_t EgHashMix(uint64_t a, uint64_t b) {
+    __uint128_t r = (__uint128_t)a * b;
+    return (uint64_t)r ^ (uint64_t)(r >> 64);
+}
+
+/**
+ * @brief 整数的哈希，低位也充分混合，可以直接与掩码相与作为桶下标
+ */
+static inline uint64_t EgHash64(uint64_t value) {
+    return EgHashMix(value ^ 0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull);
+}
+
+/**
+ * @brief 字节串的哈希（wyhash 风格），每次处理 8 字节，用于标识符、路径等短字符串
+ * @note 不是加密哈希，不能用于抵御刻意构造的碰撞
+ */
+static inline uint64_t EgHashBytes(const void* data, size_t length, uint64_t seed = 0) {
+    constexpr uint64_t kP0 = 0xa0761d6478bd642full;
+    constexpr uint64_t kP1 = 0xe7037ed1a0b428dbull;
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    auto read64 = [](const uint8_t* q) { uint64_t v; memcpy(&v, q, 8); return v; };
+
+    uint64_t h = seed ^ EgHashMix(seed ^ kP0, kP1 ^ length);
+    size_t remaining = length;
+    while (remaining > 16) {
+        h = EgHashMix(read64(p) ^ kP0, read64(p + 8) ^ h);
+        p += 16;
+        remaining -= 16;
+    }
+
+    // 尾部不超过 16 字节：用两次可能重叠的读取覆盖，避免逐字节循环
+    uint64_t a = 0;
+    uint64_t b = 0;
+    if (remaining >= 8) {
+        a = read64(p);
+        b = read64(p + remaining - 8);
+    } else if (remaining >= 4) {
+        uint32_t lo, hi;
+        memcpy(&lo, p, 4);
+        memcpy(&hi, p + remaining - 4, 4);
+        a = lo;
+        b = hi;
+    } else if (remaining > 0) {
+        a = ((uint64_t)p[0] << 16) | ((uint64_t)p[remaining >> 1] << 8) | p[remaining - 1];
+    }
+    return EgHashMix(kP1 ^ length, EgHashMix(a ^ kP0, b ^ h));
+}
@@ -6,6 +6,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <climits>
+#include <limits>
 
 class EgSafeMath {
 
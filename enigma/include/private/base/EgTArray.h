@@ -6,11 +6,14 @@
 #include "include/private/base/EgAssert.h"
 #include "include/private/base/EgTypeTraits.h"
 #include "include/private/base/EgAlignedStorage.h"
+#include "include/private/base/EgSafeMath.h"
 
 #include <algorithm>
 #include <climits>
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
+#include <new>
 
 
 /**
@@ -115,6 +118,16 @@ public:
         }
     }
 
+    /**
+     * @brief 把容量精确地扩展到 count，不额外预留；已知最终大小时避免 1.5 倍增长带来的浪费
+     */
+    void reserve_exact(int count) {
+        EgAssert(count >= 0);
+        if (count > this->capacity()) {
+            this->checkRealloc(count - this->size(), kExactFit);
+        }
+    }
+
     void reserve_back(int count) {
         EgAssert(count >= 0);
         if (count > 0) {
@@ -149,7 +162,7 @@ public:
 
     T& push_back() {
         void* newT = this->push_back_raw(1);
-        return *new T(newT);
+        return *new (newT) T;
     }
 
     T& push_back(const T& t) {
@@ -167,7 +180,7 @@ public:
         return *new (newT) T(std::forward<Args>(args)...);
     }
 
-    T* pusb_back_n(int n) {
+    T* push_back_n(int n) {
         EgAssert(n >= 0);
         T* newTs = TCast(this->push_back_raw(n));
         for (int i = 0; i < n; ++i) {
@@ -176,7 +189,7 @@ public:
         return newTs;
     }
 
-    T* pusb_back_n(int n, const T& t) {
+    T* push_back_n(int n, const T& t) {
         EgAssert(n >= 0);
         T* newTs = TCast(this->push_back_raw(n));
         for (int i = 0; i < n; ++i) {
@@ -207,6 +220,32 @@ public:
         return end;
     }
 
+    /**
+     * @brief 把 that 的所有元素移到末尾，that 变为空数组（保留其内存）
+     *
+     * 可平凡重定位的类型整块 memcpy，不逐个调用移动构造和析构。
+     * @return 指向第一个移入元素的指针
+     */
+    T* move_back(EgTArray&& that) {
+        EgAssert(this != &that);
+        const int n = that.size();
+        this->checkRealloc(n, kGrowing);
+        T* end = this->end();
+        if constexpr (MEM_MOVE) {
+            if (n > 0) {
+                memcpy(static_cast<void*>(end), static_cast<const void*>(that.mData), that.bytes(n));
+            }
+        } else {
+            for (int i = 0; i < n; ++i) {
+                new (end + i) T(std::move(that.mData[i]));
+                that.mData[i].~T();
+            }
+        }
+        mSize += n;
+        that.mSize = 0;
+        return end;
+    }
+
     void pop_back() {
         EgAssert(mSize > 0);
         --mSize;
@@ -411,13 +450,41 @@ private:
         return EgToSizeT(n) * sizeof(T);
     }
 
+    /**
+     * @brief 按增长系数计算实际分配的容量
+     *
+     * 多预留 (capacity + kMinHeapAllocCount) * (growthFactor - 1) 个元素，
+     * 连续 push_back 时重新分配的次数为对数级，小数组也至少一次预留 kMinHeapAllocCount 的一部分。
+     */
+    static int ExpandedCapacity(int capacity, double growthFactor) {
+        EgAssert(capacity >= 0);
+        if (growthFactor <= 1.0) {
+            return capacity;
+        }
+        const double extra = (capacity + kMinHeapAllocCount) * (growthFactor - 1.0);
+        return (int)std::min((double)capacity + extra, (double)kMaxCapacity);
+    }
+
+    static size_t BytesFor(int capacity) {
+        EgSafeMath safe;
+        size_t bytes = safe.mul(EgToSizeT(capacity), sizeof(T));
+        if (!safe.ok()) {
+            throw std::bad_alloc();
+        }
+        return bytes;
+    }
+
     static EgSpan<std::byte> Allocate(int capacity, double growthFactor = 1.0) {
         EgAssert(capacity >= 0);
         if (capacity == 0) {
             return {};
         }
-        size_t bytes = std::min(EgToSizeT(capacity) * sizeof(T), SIZE_MAX);
-        return {new std::byte[bytes], bytes};
+        const size_t bytes = BytesFor(ExpandedCapacity(capacity, growthFactor));
+        void* memory = malloc(bytes);
+        if (memory == nullptr) {
+            throw std::bad_alloc();
+        }
+        return {static_cast<std::byte*>(memory), bytes};
     }
 
     void initData(int count) {
@@ -473,10 +540,12 @@ private:
 
     void move(void* dst) {
         if constexpr (MEM_MOVE) {
-            memcpy(dst, mData, this->bytes(mSize));
+            if (mSize > 0) {
+                memcpy(dst, mData, this->bytes(mSize));
+            }
         } else {
             for (int i = 0; i < this->size(); ++i) {
-                new (static_cast<char*>(dst + this->bytes(i))) T(std::move(mData[i]));
+                new (static_cast<char*>(dst) + this->bytes(i)) T(std::move(mData[i]));
                 mData[i].~T();
             }
         }
@@ -503,6 +572,20 @@ private:
         }
 
         const int newCount = mSize + delta;
+        if constexpr (MEM_MOVE) {
+            // 可平凡重定位的元素由 realloc 搬移，分配器能原地扩展时完全不需要拷贝
+            if (mOwnMemory && mData != nullptr) {
+                const size_t bytes = BytesFor(ExpandedCapacity(newCount, growthFactor));
+                void* memory = realloc(static_cast<void*>(mData), bytes);
+                if (memory == nullptr) {
+                    throw std::bad_alloc();
+                }
+                this->setDataFromBytes({static_cast<std::byte*>(memory), bytes});
+                EgAssert(this->capacity() >= newCount);
+                return;
+            }
+        }
+
         EgSpan<std::byte> allocation = Allocate(newCount, growthFactor);
         this->move(TCast(allocation.data()));
         if (mOwnMemory) {
@@ -1,16 +1,30 @@
 #pragma once
 
 #include <stdarg.h>
-#include <time.h>
-#include <sys/time.h>
-#include <cstring>
-#include <sstream>
-#include <iostream>
-#include <thread>
-#include <unordered_map>
-#include <mutex>
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <ostream>
 
-#define EG_DEBUG 1
+#include "include/private/base/EgAPI.h"
+#include "include/utils/EgLogArgs.h"
+
+/**
+ * 编译期最低日志级别，低于它的 LOGx / EG_BLOGx 展开为空语句，参数表达式不参与编译产物。
+ * 取值与 EgLogLevel 一致：0 V，1 D，2 I，3 W，4 E，5 全部关闭。
+ * 默认调试构建保留全部级别，NDEBUG 构建从 I 开始；可以用 -DEG_LOG_MIN_LEVEL=N 覆盖。
+ */
+#if !defined(EG_LOG_MIN_LEVEL)
+    #if EG_DEBUG
+        #define EG_LOG_MIN_LEVEL 0
+    #else
+        #define EG_LOG_MIN_LEVEL 2
+    #endif
+#endif
+
+#if EG_LOG_MIN_LEVEL < 0 || EG_LOG_MIN_LEVEL > 5
+    #error "EG_LOG_MIN_LEVEL out of range"
+#endif
 
 #if !defined(EgDebugf)
     /**
@@ -33,89 +47,176 @@
     #define EgDEBUGF(...)
 #endif
 
+enum EgLogLevel : uint8_t {
+    gVerbose_EgLogLevel,
+    gDebug_EgLogLevel,
+    gInfo_EgLogLevel,
+    gWarn_EgLogLevel,
+    gError_EgLogLevel,
+    gLastEnum_EgLogLevel    = gError_EgLogLevel,
+
+    gSilent_EgLogLevel,     // 只用于级别设置，表示关闭全部日志
+};
+
+/**
+ * @brief 日志调用点缓存的运行期级别，每个 LOGx / EG_BLOGx 调用点一个静态实例
+ *
+ * 级别设置变化时全局代数加一，调用点发现代数不一致才重新查表，平时只有两次 relaxed 读。
+ */
+struct EgLogLevelCache {
+    std::atomic<uint32_t>   fGeneration {0};
+    std::atomic<uint8_t>    fLevel {gVerbose_EgLogLevel};
+};
+
+/**
+ * @brief 二进制日志的调用点，每个 EG_BLOG 调用点一个静态实例
+ *
+ * 首次执行时向日志后端注册，分配一个全局唯一的 fId；之后每条日志只记录 fId 和参数的原始字节。
+ */
+struct EG_API EgLogFormatSite {
+    EgLogFormatSite(EgLogLevel level, const char* tag, const char* format, const char* file, int line);
+
+    const EgLogLevel    fLevel;
+    const char* const   fTag;
+    const char* const   fFormat;
+    const char* const   fFile;
+    const int           fLine;
+    uint32_t            fId;
+};
+
+/**
+ * 异步日志
+ *
+ * 调用线程只把消息拷贝进本线程的无锁环形缓冲区，时间、线程名等前缀的格式化
+ * 以及对输出的写入都在后台写线程中批量完成。环形缓冲区写满时丢弃新消息并计数，
+ * 调用线程永远不会因为输出慢而阻塞。
+ */
+namespace EgLog {
+
+    /**
+     * @brief 级别设置的代数，从 1 开始，每次 SetLevel / SetTagLevel 加一
+     */
+    EG_API extern std::atomic<uint32_t> gLevelGeneration;
+
+    /**
+     * @brief 查表得到 tag 的运行期级别：有单独设置时用它，否则用全局级别
+     */
+    EG_API EgLogLevel LevelForTag(const char* tag);
+
+    /**
+     * @brief 设置全局运行期级别，低于它的日志在调用点直接跳过，参数不会被求值
+     */
+    EG_API void SetLevel(EgLogLevel level);
+
+    /**
+     * @brief 单独设置某个 tag 的级别，优先于全局级别，gSilent_EgLogLevel 表示关闭该 tag
+     */
+    EG_API void SetTagLevel(const char* tag, EgLogLevel level);
+
+    /**
+     * @brief 清除 SetTagLevel 的单独设置
+     */
+    EG_API void ClearTagLevels();
 
-// 获取当前时间并格式化为字符串
-static char* log_time(void) {
-
-    // 线程局部存储的时间字符串缓冲区
-    thread_local char szTime[26];
-
-    // 定义一个 timeval 结构体，用于存储时间戳
-    struct timeval tv {};
-    // 定义一个 timezone 结构体，用于存储时区信息
-    struct timezone tz {};
-    // 获取当前时间戳和时区信息
-    gettimeofday(&tv, &tz);
-
-    // 将时间戳转换为本地时间
-    struct tm* ptm = localtime(&tv.tv_sec);
-    // 将本地时间格式化为字符串，格式为 "YYYY-MM-DD HH:MM:SS"
-    strftime(szTime, sizeof(szTime) - 5, "%Y-%m-%d %H:%M:%S", ptm);
-    // 计算毫秒数
-    int millis = tv.tv_usec / 1000;
-
-    // 将毫秒数格式化为字符串，格式为 ".SSS"
-    snprintf(szTime + strlen(szTime), 5, ".%03d", millis);
-    // 返回时间字符串
-    return szTime;
-}
-
-static std::string getCurrentThreadIdHex() {
-    std::stringstream ss;
-    ss << std::hex << std::this_thread::get_id();
-    return ss.str();
-}
-
-static int getCurrentTid() {
-    static std::unordered_map<std::thread::id, int> threadIdMap;
-    static std::mutex mutex;
-    auto id = std::this_thread::get_id();
-
-    std::lock_guard<std::mutex> lock(mutex);
-    if (threadIdMap.find(id) == threadIdMap.end()) {
-        threadIdMap[id] = threadIdMap.size();
+    inline bool IsEnabled(EgLogLevel level, const char* tag, EgLogLevelCache& cache) {
+        const uint32_t generation = gLevelGeneration.load(std::memory_order_acquire);
+        if (cache.fGeneration.load(std::memory_order_relaxed) != generation) {
+            cache.fLevel.store(LevelForTag(tag), std::memory_order_relaxed);
+            cache.fGeneration.store(generation, std::memory_order_relaxed);
+        }
+        return level >= cache.fLevel.load(std::memory_order_relaxed);
     }
-    return threadIdMap[id];
-}
-
-static std::string getCurrentThreadName() {
-    char name[16]; // 线程名称的最大长度为16
-    pthread_getname_np(pthread_self(), name, sizeof(name));
-    return std::string(name);
-}
-
-static void __print(const std::stringstream& sstream) {
-    std::cout << sstream.str() << std::endl << std::flush;
-}
-
-template<typename T>
-static void __print(const std::stringstream& sstream, const T& value) {
-    sstream << value << std::endl;
-    std::cout << sstream.str() << std::flush;
-}
-
-template<typename T, typename... Args>
-static void __print(const std::stringstream& sstream, const T& value, const Args&... args) {
-    sstream << value;
-    __print(sstream, args...);
-}
-
-template<typename T, typename... Args>
-static void __println(const std::string& type, const T& value, const Args&... args) {
-    std::stringstream sstream;
+
+    /**
+     * @brief 提交一条日志
+     * @param tag 必须是静态生命周期的字符串（通常为 LOG_TAG 字面量）
+     */
+    EG_API void Write(EgLogLevel level, const char* tag, const char* message, size_t length);
+
+    /**
+     * @brief 提交一条二进制日志：只记录调用点 ID 和参数的原始字节
+     */
+    EG_API void WriteBinary(const EgLogFormatSite& site, const uint8_t* args, size_t length);
+
+    template <typename... Args>
+    inline void WriteArgs(const EgLogFormatSite& site, const Args&... args) {
+        uint8_t buffer[512];
+        EgLogArgs::Writer writer(buffer, sizeof(buffer));
+        EgLogArgs::EncodeAll(writer, args...);
+        WriteBinary(site, writer.data(), writer.size());
+    }
+
+    /**
+     * @brief 只用于编译期检查 EG_BLOG 的格式串与参数是否匹配，从不被调用
+     */
+    [[gnu::format(printf, 1, 2)]] inline void CheckFormat(const char*, ...) {}
+
+    /**
+     * @brief 切换为二进制输出：写入文件头，此后所有日志（包括 LOGx）都以二进制记录写入 fd，
+     *        由 eg_logdecode 离线还原为文本。传入 -1 恢复文本输出
+     */
+    EG_API void SetBinaryOutputFd(int fd);
+
+    /**
+     * @brief 阻塞直到此前提交的日志全部写出
+     */
+    EG_API void Flush();
+
+    /**
+     * @brief 设置当前线程的名字并同步到日志前缀中
+     *
+     * 线程名在线程第一次写日志时缓存，之后直接调用 pthread_setname_np 改名不会反映到日志里。
+     */
+    EG_API void SetThreadName(const char* name);
+
+    /**
+     * @brief 设置输出的文件描述符，默认为标准输出
+     */
+    EG_API void SetOutputFd(int fd);
+
+    /**
+     * @brief 本线程复用的格式化流，直接写入固定大小的线程局部缓冲，不分配内存，超长部分被截断
+     */
+    EG_API std::ostream& BeginStream();
+
+    EG_API void EndStream(EgLogLevel level, const char* tag, std::ostream& stream);
+
+};
 
 #ifndef LOG_TAG
 #define LOG_TAG "NO_TAG"
 #endif
 
-    std::string tagStr(LOG_TAG);
-    tagStr.substr(0, 10);
-    tagStr.resize(10, ' ');
+/**
+ * 运行期被过滤的日志在这里跳过，流表达式 / 参数都不会被求值
+ */
+#define EG_LOG_STREAM(level, ...) do {                                  \
+        static EgLogLevelCache eg_log_level_cache;                       \
+        if (EgLog::IsEnabled(level, LOG_TAG, eg_log_level_cache)) {      \
+            std::ostream& eg_log_stream = EgLog::BeginStream();          \
+            eg_log_stream << __VA_ARGS__;                                 \
+            EgLog::EndStream(level, LOG_TAG, eg_log_stream);              \
+        }                                                                 \
+    } while (0)
 
-    sstream << log_time() << " " << getCurrentThreadName() << " " << type << "/" << tagStr << ": " << value;
-    __print(sstream, args...);
-}
+/**
+ * 二进制日志，格式串为 printf 风格，参数只能是算术类型、指针或 C 字符串
+ * 示例用法：
+ *    EG_BLOGD("frame %d took %.2f ms", frameIndex, ms);
+ *
+ * 调用线程不做任何格式化，只拷贝参数字节；文本模式下由写线程格式化，
+ * 二进制模式下格式化推迟到离线的 eg_logdecode。
+ */
+#define EG_BLOG(level, format, ...) do {                                                    \
+        if (false) { EgLog::CheckFormat(format, ##__VA_ARGS__); }                          \
+        static EgLogLevelCache eg_log_level_cache;                                           \
+        if (EgLog::IsEnabled(level, LOG_TAG, eg_log_level_cache)) {                          \
+            static EgLogFormatSite eg_log_site(level, LOG_TAG, format, __FILE__, __LINE__); \
+            EgLog::WriteArgs(eg_log_site, ##__VA_ARGS__);                                   \
+        }                                                                                     \
+    } while (0)
 
+#define EG_LOG_DISABLED(...) do {} while (0)
 
 /**
  * 打印日志信息
@@ -124,37 +225,42 @@ static void __println(const std::string& type, const T& value, const Args&... ar
  *    LOGD("Value: " << 42);
  *    LOGD("Value:" << "Hello");
  */
-#if defined(EG_DEBUG) && EG_DEBUG == 1
-    #define LOGV(...) {\
-        std::ostringstream ostr;\
-        ostr << __VA_ARGS__;\
-        __println("V", ostr.str());\
-    }
+#if EG_LOG_MIN_LEVEL <= 0
+    #define LOGV(...) EG_LOG_STREAM(gVerbose_EgLogLevel, __VA_ARGS__)
+    #define EG_BLOGV(format, ...) EG_BLOG(gVerbose_EgLogLevel, format, ##__VA_ARGS__)
+#else
+    #define LOGV(...) EG_LOG_DISABLED()
+    #define EG_BLOGV(...) EG_LOG_DISABLED()
+#endif
 
-    #define LOGD(...) {\
-        std::ostringstream ostr;\
-        ostr << __VA_ARGS__;\
-        __println("D", ostr.str());\
-    }
-    #define LOGI(...) {\
-        std::ostringstream ostr;\
-        ostr << __VA_ARGS__;\
-        __println("I", ostr.str());\
-    }
-    #define LOGW(...) {\
-        std::ostringstream ostr;\
-        ostr << __VA_ARGS__;\
-        __println("W", ostr.str());\
-    }
-    #define LOGE(...) {\
-        std::ostringstream ostr;\
-        ostr << __VA_ARGS__;\
-        __println("E", ostr.str());\
-    }
+#if EG_LOG_MIN_LEVEL <= 1
+    #define LOGD(...) EG_LOG_STREAM(gDebug_EgLogLevel, __VA_ARGS__)
+    #define EG_BLOGD(format, ...) EG_BLOG(gDebug_EgLogLevel, format, ##__VA_ARGS__)
 #else
-    #define LOGV(...) {}
-    #define LOGD(...) {}
-    #define LOGI(...) {}
-    #define LOGW(...) {}
-    #define LOGE(...) {}
-#endif
\ No newline at end of file
+    #define LOGD(...) EG_LOG_DISABLED()
+    #define EG_BLOGD(...) EG_LOG_DISABLED()
+#endif
+
+#if EG_LOG_MIN_LEVEL <= 2
+    #define LOGI(...) EG_LOG_STREAM(gInfo_EgLogLevel, __VA_ARGS__)
+    #define EG_BLOGI(format, ...) EG_BLOG(gInfo_EgLogLevel, format, ##__VA_ARGS__)
+#else
+    #define LOGI(...) EG_LOG_DISABLED()
+    #define EG_BLOGI(...) EG_LOG_DISABLED()
+#endif
+
+#if EG_LOG_MIN_LEVEL <= 3
+    #define LOGW(...) EG_LOG_STREAM(gWarn_EgLogLevel, __VA_ARGS__)
+    #define EG_BLOGW(format, ...) EG_BLOG(gWarn_EgLogLevel, format, ##__VA_ARGS__)
+#else
+    #define LOGW(...) EG_LOG_DISABLED()
+    #define EG_BLOGW(...) EG_LOG_DISABLED()
+#endif
+
+#if EG_LOG_MIN_LEVEL <= 4
+    #define LOGE(...) EG_LOG_STREAM(gError_EgLogLevel, __VA_ARGS__)
+    #define EG_BLOGE(format, ...) EG_BLOG(gError_EgLogLevel, format, ##__VA_ARGS__)
+#else
+    #define LOGE(...) EG_LOG_DISABLED()
+    #define EG_BLOGE(...) EG_LOG_DISABLED()
+#endif
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * 二进制日志的参数编码
+ *
+ * 每个参数编码为 1 字节类型标记加原始字节（主机字节序）：
+ * - gInt     : int64_t
+ * - gUInt    : uint64_t
+ * - gDouble  : double
+ * - gPointer : uint64_t
+ * - gString  : uint32_t 长度 + 字节，不含结尾的 '\0'
+ * 格式化推迟到写线程或离线的 eg_logdecode 中完成。
+ */
+namespace EgLogArgs {
+
+    enum Type : uint8_t {
+        gInt        = 'i',
+        gUInt       = 'u',
+        gDouble     = 'd',
+        gPointer    = 'p',
+        gString     = 's',
+    };
+
+    class Writer {
+    public:
+        Writer(uint8_t* buffer, size_t size) : fBegin(buffer), fCur(buffer), fEnd(buffer + size) {}
+
+        void put(Type type, const void* data, size_t size) {
+            if ((size_t)(fEnd - fCur) < 1 + size) {
+                fEnd = fCur;    // 空间不足，之后的参数全部丢弃，解码时按缺失参数处理
+                return;
+            }
+            *fCur++ = type;
+            memcpy(fCur, data, size);
+            fCur += size;
+        }
+
+        void putString(const char* str) {
+            if (str == nullptr) {
+                str = "(null)";
+            }
+            size_t available = (size_t)(fEnd - fCur);
+            if (available < 1 + sizeof(uint32_t)) {
+                fEnd = fCur;
+                return;
+            }
+            uint32_t length = (uint32_t)strnlen(str, available - 1 - sizeof(uint32_t));
+            *fCur++ = gString;
+            memcpy(fCur, &length, sizeof(length));
+            fCur += sizeof(length);
+            memcpy(fCur, str, length);
+            fCur += length;
+        }
+
+        const uint8_t* data() const { return fBegin; }
+        size_t size() const { return (size_t)(fCur - fBegin); }
+
+    private:
+        uint8_t*    fBegin;
+        uint8_t*    fCur;
+        uint8_t*    fEnd;
+    };
+
+    template <typename T>
+    inline void Encode(Writer& writer, const T& value) {
+        using U = std::decay_t<T>;
+        if constexpr (std::is_same_v<U, char*> || std::is_same_v<U, const char*>) {
+            writer.putString(value);
+        } else if constexpr (std::is_floating_point_v<U>) {
+            double v = (double)value;
+            writer.put(gDouble, &v, sizeof(v));
+        } else if constexpr (std::is_integral_v<U> || std::is_enum_v<U>) {
+            if constexpr (std::is_signed_v<U> || std::is_enum_v<U>) {
+                int64_t v = (int64_t)value;
+                writer.put(gInt, &v, sizeof(v));
+            } else {
+                uint64_t v = (uint64_t)value;
+                writer.put(gUInt, &v, sizeof(v));
+            }
+        } else if constexpr (std::is_pointer_v<U> || std::is_null_pointer_v<U>) {
+            uint64_t v = (uint64_t)(uintptr_t)value;
+            writer.put(gPointer, &v, sizeof(v));
+        } else {
+            static_assert(std::is_arithmetic_v<U>, "binary log arguments must be arithmetic, pointers or C strings");
+        }
+    }
+
+    template <typename... Args>
+    inline void EncodeAll(Writer& writer, const Args&... args) {
+        (Encode(writer, args), ...);
+    }
+
+};
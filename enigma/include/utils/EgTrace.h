@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "include/private/base/EgAPI.h"
+
+/**
+ * 编译期开关，为 0 时所有 EG_TRACE_EVENT 展开为空语句
+ */
+#if !defined(EG_TRACE_ENABLED)
+    #define EG_TRACE_ENABLED 1
+#endif
+
+/**
+ * 时间线追踪
+ *
+ * 作用域事件在结束时作为一条 Chrome trace 的 "X"（complete）事件写入本线程的缓冲区，
+ * 不加锁也不格式化；Dump 时才生成 JSON，可直接在 chrome://tracing 或 ui.perfetto.dev 中打开。
+ * 未开启追踪时，每个事件只有一次 relaxed 原子读的开销。
+ *
+ * Start / Stop / Dump 应在同一个控制线程中调用，Dump 在 Stop 之后调用。
+ */
+namespace EgTrace {
+
+    EG_API extern std::atomic<bool> gEnabled;
+
+    inline bool IsEnabled() { return gEnabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 清空各线程已记录的事件并开始记录
+     */
+    EG_API void Start();
+
+    EG_API void Stop();
+
+    /**
+     * @brief 把记录的事件以 Chrome trace JSON 格式写入文件
+     * @return 文件无法打开时返回 false
+     */
+    EG_API bool Dump(const char* path);
+
+    EG_API uint64_t NowNs();
+
+    /**
+     * @brief 记录一条完整事件，category、name、argName 必须是静态生命周期的字符串
+     */
+    EG_API void AddCompleteEvent(const char* category, const char* name, uint64_t startNs, uint64_t endNs,
+                                 const char* argName, int64_t argValue);
+
+};
+
+/**
+ * @brief EG_TRACE_EVENT 使用的作用域对象，构造时记下开始时间，析构时提交事件
+ */
+class EgTraceScope {
+public:
+    EgTraceScope(const char* category, const char* name, const char* argName = nullptr, int64_t argValue = 0) {
+        if (EgTrace::IsEnabled()) {
+            fCategory = category;
+            fName     = name;
+            fArgName  = argName;
+            fArgValue = argValue;
+            fStartNs  = EgTrace::NowNs();
+        }
+    }
+
+    ~EgTraceScope() {
+        if (fCategory) {
+            EgTrace::AddCompleteEvent(fCategory, fName, fStartNs, EgTrace::NowNs(), fArgName, fArgValue);
+        }
+    }
+
+    EgTraceScope(const EgTraceScope&) = delete;
+    EgTraceScope& operator=(const EgTraceScope&) = delete;
+
+private:
+    const char*     fCategory = nullptr;
+    const char*     fName;
+    const char*     fArgName;
+    int64_t         fArgValue;
+    uint64_t        fStartNs;
+};
+
+#define EG_TRACE_CONCAT_IMPL(a, b) a##b
+#define EG_TRACE_CONCAT(a, b) EG_TRACE_CONCAT_IMPL(a, b)
+
+/**
+ * 追踪当前作用域
+ * 示例用法：
+ *    EG_TRACE_EVENT("raster", "EgRasterPipeline::run");
+ *    EG_TRACE_EVENT1("imagefilter", "FilterLayer", "tiles", tileCount);
+ */
+#if EG_TRACE_ENABLED
+    #define EG_TRACE_EVENT(category, name) \
+        EgTraceScope EG_TRACE_CONCAT(eg_trace_scope_, __LINE__)(category, name)
+    #define EG_TRACE_EVENT1(category, name, argName, argValue) \
+        EgTraceScope EG_TRACE_CONCAT(eg_trace_scope_, __LINE__)(category, name, argName, (int64_t)(argValue))
+#else
+    #define EG_TRACE_EVENT(category, name) do {} while (0)
+    #define EG_TRACE_EVENT1(category, name, argName, argValue) do {} while (0)
+#endif
@@ -0,0 +1,63 @@
+#include "src/base/EgArenaAlloc.h"
+
+#include "include/core/EgMemory.h"
+
+#include <algorithm>
+
+EgArenaAlloc::EgArenaAlloc(char* block, size_t blockSize, size_t firstHeapAllocation)
+    : fFirstBlock(blockSize ? block : nullptr)
+    , fFirstBlockSize(block ? blockSize : 0)
+    , fFirstHeapAllocation(std::max<size_t>(firstHeapAllocation, 256))
+    , fCursor(reinterpret_cast<uintptr_t>(fFirstBlock))
+    , fEnd(reinterpret_cast<uintptr_t>(fFirstBlock) + fFirstBlockSize)
+    , fNextHeapAllocation(fFirstHeapAllocation) {
+}
+
+EgArenaAlloc::~EgArenaAlloc() {
+    this->reset();
+}
+
+void EgArenaAlloc::runDestructors() {
+    // 后创建的对象可能引用先创建的对象，按逆序析构
+    while (fFooters != nullptr) {
+        Footer* footer = fFooters;
+        fFooters = footer->fPrev;
+        footer->fDestroy(footer->fObjects, footer->fCount);
+    }
+}
+
+void EgArenaAlloc::reset() {
+    this->runDestructors();
+    while (fBlocks != nullptr) {
+        Block* block = fBlocks;
+        fBlocks = block->fPrev;
+        EgMemory::Free(gOther_EgMemorySubsystem, block);
+    }
+    fCursor = reinterpret_cast<uintptr_t>(fFirstBlock);
+    fEnd = reinterpret_cast<uintptr_t>(fFirstBlock) + fFirstBlockSize;
+    fNextHeapAllocation = fFirstHeapAllocation;
+    fHeapBytes = 0;
+}
+
+void EgArenaAlloc::allocBlock(size_t size, size_t align) {
+    // 块头之后按 align 对齐，最坏情况下需要额外 align - 1 字节
+    EgAssertRelease(size <= SIZE_MAX / 2 && align <= 4096);
+    const size_t required = sizeof(Block) + size + align - 1;
+    size_t blockSize = fNextHeapAllocation;
+    while (blockSize < required) {
+        blockSize *= 2;
+    }
+    fNextHeapAllocation = std::min<size_t>(blockSize * 2, SIZE_MAX / 4);
+
+    void* memory = EgMemory::Malloc(gOther_EgMemorySubsystem, blockSize);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    Block* block = static_cast<Block*>(memory);
+    block->fPrev = fBlocks;
+    fBlocks = block;
+    fHeapBytes += blockSize;
+
+    fCursor = reinterpret_cast<uintptr_t>(block + 1);
+    fEnd = reinterpret_cast<uintptr_t>(memory) + blockSize;
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+#include "include/private/base/EgAlignedStorage.h"
+#include "include/private/base/EgAssert.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief 顺序分配（bump pointer）的内存池，用于生命周期相同的一批对象，例如一帧内的临时对象
+ *
+ * 先用调用者提供的内存块（通常在栈上，见 EgSTArenaAlloc），用完后从堆上分配新块，
+ * 块大小按 2 倍增长。只有非平凡析构的对象才在其后记录一个析构记录（Footer），
+ * 析构或 reset 时按创建的逆序调用析构函数，然后一次性释放所有堆块。
+ * 单个对象不能单独释放。
+ */
+class EgArenaAlloc {
+public:
+    /**
+     * @param block 初始内存块，可以为 nullptr
+     * @param blockSize 初始内存块的字节数
+     * @param firstHeapAllocation 第一个堆块的字节数，之后每块翻倍
+     */
+    EgArenaAlloc(char* block, size_t blockSize, size_t firstHeapAllocation);
+
+    explicit EgArenaAlloc(size_t firstHeapAllocation) : EgArenaAlloc(nullptr, 0, firstHeapAllocation) {}
+
+    ~EgArenaAlloc();
+
+    EgArenaAlloc(const EgArenaAlloc&) = delete;
+    EgArenaAlloc& operator=(const EgArenaAlloc&) = delete;
+
+    template <typename T, typename... Args>
+    T* make(Args&&... args) {
+        void* memory = this->allocAligned(sizeof(T), alignof(T));
+        T* object = new (memory) T(std::forward<Args>(args)...);
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            this->installFooter(&DestroyArray<T>, object, 1);
+        }
+        return object;
+    }
+
+    /**
+     * @brief 分配 count 个值初始化的 T
+     */
+    template <typename T>
+    T* makeArray(size_t count) {
+        T* array = this->allocArray<T>(count);
+        for (size_t i = 0; i < count; ++i) {
+            new (array + i) T();
+        }
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            this->installFooter(&DestroyArray<T>, array, count);
+        }
+        return array;
+    }
+
+    /**
+     * @brief 分配 count 个默认初始化的 T，平凡类型不做初始化
+     */
+    template <typename T>
+    T* makeArrayDefault(size_t count) {
+        T* array = this->allocArray<T>(count);
+        if constexpr (!std::is_trivially_default_constructible_v<T> || !std::is_trivially_destructible_v<T>) {
+            for (size_t i = 0; i < count; ++i) {
+                new (array + i) T;
+            }
+        }
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            this->installFooter(&DestroyArray<T>, array, count);
+        }
+        return array;
+    }
+
+    void* makeBytesAlignedTo(size_t size, size_t align) {
+        return this->allocAligned(size, align);
+    }
+
+    /**
+     * @brief 析构所有对象并释放堆块，之后可以继续分配，初始内存块会被复用
+     */
+    void reset();
+
+    /**
+     * @brief 已从堆上分配的字节数，用于调整初始块和 firstHeapAllocation
+     */
+    size_t heapBytes() const { return fHeapBytes; }
+
+private:
+    using DestroyFn = void (*)(void* objects, size_t count);
+
+    struct Footer {
+        DestroyFn   fDestroy;
+        void*       fObjects;
+        size_t      fCount;
+        Footer*     fPrev;
+    };
+
+    struct Block {
+        Block*      fPrev;
+    };
+
+    template <typename T>
+    static void DestroyArray(void* objects, size_t count) {
+        T* array = static_cast<T*>(objects);
+        for (size_t i = count; i > 0; --i) {
+            array[i - 1].~T();
+        }
+    }
+
+    template <typename T>
+    T* allocArray(size_t count) {
+        EgAssertRelease(count <= SIZE_MAX / sizeof(T));
+        return static_cast<T*>(this->allocAligned(count * sizeof(T), alignof(T)));
+    }
+
+    void* allocAligned(size_t size, size_t align) {
+        uintptr_t start = (fCursor + align - 1) & ~(uintptr_t)(align - 1);
+        if (fCursor == 0 || start > fEnd || size > fEnd - start) {
+            this->allocBlock(size, align);
+            start = (fCursor + align - 1) & ~(uintptr_t)(align - 1);
+        }
+        fCursor = start + size;
+        return reinterpret_cast<void*>(start);
+    }
+
+    void installFooter(DestroyFn destroy, void* objects, size_t count) {
+        Footer* footer = static_cast<Footer*>(this->allocAligned(sizeof(Footer), alignof(Footer)));
+        *footer = {destroy, objects, count, fFooters};
+        fFooters = footer;
+    }
+
+    /**
+     * @brief 分配一个至少能放下 size 字节（按 align 对齐）的堆块并切换过去
+     */
+    void allocBlock(size_t size, size_t align);
+
+    void runDestructors();
+
+    char* const     fFirstBlock;
+    const size_t    fFirstBlockSize;
+    const size_t    fFirstHeapAllocation;
+
+    uintptr_t       fCursor;
+    uintptr_t       fEnd;
+    size_t          fNextHeapAllocation;
+    size_t          fHeapBytes = 0;
+    Footer*         fFooters = nullptr;
+    Block*          fBlocks = nullptr;
+};
+
+/**
+ * @brief 自带 kInlineBytes 字节初始块的 EgArenaAlloc，放在栈上时大多数帧内分配都不触碰堆
+ * 示例用法：
+ *    EgSTArenaAlloc<1024> alloc;
+ *    EgRasterPipeline pipeline(&alloc);
+ */
+template <size_t kInlineBytes>
+class EgSTArenaAlloc : private EgAlignedStorage<(int)((kInlineBytes + sizeof(std::max_align_t) - 1) /
+                                                  sizeof(std::max_align_t)), std::max_align_t>,
+                       public EgArenaAlloc {
+    // EgAlignedStorage 的 N 是 max_align_t 的个数（x86-64 上每个 32 字节），不是字节数
+    using Storage = EgAlignedStorage<(int)((kInlineBytes + sizeof(std::max_align_t) - 1) /
+                                           sizeof(std::max_align_t)), std::max_align_t>;
+
+public:
+    explicit EgSTArenaAlloc(size_t firstHeapAllocation = kInlineBytes)
+        : EgArenaAlloc(reinterpret_cast<char*>(Storage::data()), Storage::size(), firstHeapAllocation) {}
+};
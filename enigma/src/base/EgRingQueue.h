@@ -0,0 +1,328 @@
+#pragma once
+
+#include "include/private/base/EgAssert.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * 有界无锁环形队列，用于线程间传递对象（录制好的帧、资源上传请求等），不经过互斥锁。
+ *
+ * - EgSPSCQueue：单生产者单消费者，两端各自只写自己的下标；
+ * - EgMPSCQueue：多生产者单消费者，生产者用 CAS 争抢位置，每个槽位带序号标记是否已写完。
+ *
+ * 容量在构造时确定，向上取整到 2 的幂。队列满时 push 返回 false，由调用者决定丢弃、重试还是等待。
+ * 生产者和消费者的下标放在不同的缓存行，避免互相使对方的缓存行失效。
+ */
+
+static constexpr size_t kEgCacheLineSize = 64;
+
+namespace EgRingQueuePriv {
+
+static inline size_t round_up_pow2(size_t count) {
+    size_t capacity = 1;
+    while (capacity < count) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+template <typename T>
+static inline T* alloc_slots(size_t capacity) {
+    return static_cast<T*>(::operator new(capacity * sizeof(T), std::align_val_t(alignof(T))));
+}
+
+template <typename T>
+static inline void free_slots(T* slots) {
+    ::operator delete(slots, std::align_val_t(alignof(T)));
+}
+
+}  // namespace EgRingQueuePriv
+
+/**
+ * @brief 单生产者单消费者队列
+ *
+ * 生产者只写 fHead，消费者只写 fTail；各自缓存一份对方的下标，
+ * 只在缓存值显示满 / 空时才重新读取，稳定状态下两端不共享可写的缓存行。
+ */
+template <typename T>
+class EgSPSCQueue {
+public:
+    explicit EgSPSCQueue(size_t capacity)
+        : fMask(EgRingQueuePriv::round_up_pow2(capacity < 2 ? 2 : capacity) - 1)
+        , fSlots(EgRingQueuePriv::alloc_slots<T>(fMask + 1)) {}
+
+    ~EgSPSCQueue() {
+        const size_t head = fHead.load(std::memory_order_acquire);
+        for (size_t i = fTail.load(std::memory_order_relaxed); i != head; ++i) {
+            fSlots[i & fMask].~T();
+        }
+        EgRingQueuePriv::free_slots(fSlots);
+    }
+
+    EgSPSCQueue(const EgSPSCQueue&) = delete;
+    EgSPSCQueue& operator=(const EgSPSCQueue&) = delete;
+
+    size_t capacity() const { return fMask + 1; }
+
+    /**
+     * @brief 近似的元素个数，另一端同时在操作时只能作为参考
+     */
+    size_t sizeApprox() const {
+        return fHead.load(std::memory_order_acquire) - fTail.load(std::memory_order_acquire);
+    }
+
+    bool empty() const { return this->sizeApprox() == 0; }
+
+    // ---- 生产者 ----
+
+    template <typename... Args>
+    bool tryEmplace(Args&&... args) {
+        const size_t head = fHead.load(std::memory_order_relaxed);
+        if (head - fCachedTail == this->capacity()) {
+            fCachedTail = fTail.load(std::memory_order_acquire);
+            if (head - fCachedTail == this->capacity()) {
+                return false;
+            }
+        }
+        new (&fSlots[head & fMask]) T(std::forward<Args>(args)...);
+        fHead.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPush(const T& item) { return this->tryEmplace(item); }
+    bool tryPush(T&& item) { return this->tryEmplace(std::move(item)); }
+
+    /**
+     * @brief 尽量多地移入 items 中的元素，只发布一次下标
+     * @return 实际放入的个数，items 的前这么多个元素被移走
+     */
+    size_t tryPushBatch(T* items, size_t count) {
+        const size_t head = fHead.load(std::memory_order_relaxed);
+        size_t space = this->capacity() - (head - fCachedTail);
+        if (space < count) {
+            fCachedTail = fTail.load(std::memory_order_acquire);
+            space = this->capacity() - (head - fCachedTail);
+        }
+        const size_t n = count < space ? count : space;
+        for (size_t i = 0; i < n; ++i) {
+            new (&fSlots[(head + i) & fMask]) T(std::move(items[i]));
+        }
+        if (n) {
+            fHead.store(head + n, std::memory_order_release);
+        }
+        return n;
+    }
+
+    // ---- 消费者 ----
+
+    bool tryPop(T* item) {
+        const size_t tail = fTail.load(std::memory_order_relaxed);
+        if (tail == fCachedHead) {
+            fCachedHead = fHead.load(std::memory_order_acquire);
+            if (tail == fCachedHead) {
+                return false;
+            }
+        }
+        T& slot = fSlots[tail & fMask];
+        *item = std::move(slot);
+        slot.~T();
+        fTail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief 最多取出 maxCount 个元素，只发布一次下标
+     * @return 实际取出的个数
+     */
+    size_t tryPopBatch(T* items, size_t maxCount) {
+        const size_t tail = fTail.load(std::memory_order_relaxed);
+        size_t available = fCachedHead - tail;
+        if (available < maxCount) {
+            fCachedHead = fHead.load(std::memory_order_acquire);
+            available = fCachedHead - tail;
+        }
+        const size_t n = maxCount < available ? maxCount : available;
+        for (size_t i = 0; i < n; ++i) {
+            T& slot = fSlots[(tail + i) & fMask];
+            items[i] = std::move(slot);
+            slot.~T();
+        }
+        if (n) {
+            fTail.store(tail + n, std::memory_order_release);
+        }
+        return n;
+    }
+
+private:
+    const size_t    fMask;
+    T* const        fSlots;
+
+    alignas(kEgCacheLineSize) std::atomic<size_t> fHead {0};
+    size_t fCachedTail = 0;     // 生产者私有
+
+    alignas(kEgCacheLineSize) std::atomic<size_t> fTail {0};
+    size_t fCachedHead = 0;     // 消费者私有
+};
+
+/**
+ * @brief 多生产者单消费者队列
+ *
+ * 每个槽位有一个序号：等于位置 pos 时表示空闲、可由拿到 pos 的生产者写入，
+ * 等于 pos + 1 时表示已写完、可由消费者读取，消费者读完后设为 pos + capacity 交给下一轮。
+ * 生产者先 CAS 推进 fHead 占位，再写入并发布序号，因此一个生产者被挂起时
+ * 只会挡住消费者读它之后的元素，不会挡住其他生产者。
+ */
+template <typename T>
+class EgMPSCQueue {
+public:
+    explicit EgMPSCQueue(size_t capacity)
+        : fMask(EgRingQueuePriv::round_up_pow2(capacity < 2 ? 2 : capacity) - 1)
+        , fCells(EgRingQueuePriv::alloc_slots<Cell>(fMask + 1)) {
+        for (size_t i = 0; i <= fMask; ++i) {
+            new (&fCells[i].fSequence) std::atomic<size_t>(i);
+        }
+    }
+
+    ~EgMPSCQueue() {
+        // 析构时不应再有生产者，[tail, head) 中的元素都已写完
+        const size_t head = fHead.load(std::memory_order_acquire);
+        for (size_t i = fTail.load(std::memory_order_relaxed); i != head; ++i) {
+            fCells[i & fMask].item()->~T();
+        }
+        for (size_t i = 0; i <= fMask; ++i) {
+            fCells[i].fSequence.~atomic();
+        }
+        EgRingQueuePriv::free_slots(fCells);
+    }
+
+    EgMPSCQueue(const EgMPSCQueue&) = delete;
+    EgMPSCQueue& operator=(const EgMPSCQueue&) = delete;
+
+    size_t capacity() const { return fMask + 1; }
+
+    size_t sizeApprox() const {
+        const size_t tail = fTail.load(std::memory_order_acquire);
+        const size_t head = fHead.load(std::memory_order_acquire);
+        return head > tail ? head - tail : 0;
+    }
+
+    bool empty() const { return this->sizeApprox() == 0; }
+
+    // ---- 生产者，可在任意线程调用 ----
+
+    template <typename... Args>
+    bool tryEmplace(Args&&... args) {
+        size_t pos = fHead.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = fCells[pos & fMask];
+            const intptr_t diff = (intptr_t)cell.fSequence.load(std::memory_order_acquire) - (intptr_t)pos;
+            if (diff == 0) {
+                if (fHead.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    new (cell.item()) T(std::forward<Args>(args)...);
+                    cell.fSequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                // 这一格上一轮的元素还没被消费，队列已满
+                return false;
+            } else {
+                pos = fHead.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool tryPush(const T& item) { return this->tryEmplace(item); }
+    bool tryPush(T&& item) { return this->tryEmplace(std::move(item)); }
+
+    /**
+     * @brief 一次 CAS 占下连续的多个位置后依次写入
+     * @return 实际放入的个数，items 的前这么多个元素被移走
+     */
+    size_t tryPushBatch(T* items, size_t count) {
+        size_t pos = fHead.load(std::memory_order_relaxed);
+        size_t n;
+        for (;;) {
+            // 消费者按顺序释放槽位，[tail, tail + capacity) 之内、pos 之后的槽位都是空闲的
+            const size_t tail = fTail.load(std::memory_order_acquire);
+            const size_t used = pos - tail;
+            if ((intptr_t)used < 0) {
+                // pos 读得比 tail 早，已经过时
+                pos = fHead.load(std::memory_order_relaxed);
+                continue;
+            }
+            const size_t space = used < this->capacity() ? this->capacity() - used : 0;
+            n = count < space ? count : space;
+            if (n == 0) {
+                return 0;
+            }
+            if (fHead.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+
+        for (size_t i = 0; i < n; ++i) {
+            Cell& cell = fCells[(pos + i) & fMask];
+            new (cell.item()) T(std::move(items[i]));
+            cell.fSequence.store(pos + i + 1, std::memory_order_release);
+        }
+        return n;
+    }
+
+    // ---- 消费者，只能在一个线程调用 ----
+
+    bool tryPop(T* item) {
+        const size_t pos = fTail.load(std::memory_order_relaxed);
+        Cell& cell = fCells[pos & fMask];
+        if (cell.fSequence.load(std::memory_order_acquire) != pos + 1) {
+            // 队列为空，或者占到这一格的生产者还没写完
+            return false;
+        }
+        T* slot = cell.item();
+        *item = std::move(*slot);
+        slot->~T();
+        cell.fSequence.store(pos + this->capacity(), std::memory_order_release);
+        fTail.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief 最多取出 maxCount 个已写完的元素，遇到尚未写完的位置就停下
+     */
+    size_t tryPopBatch(T* items, size_t maxCount) {
+        const size_t tail = fTail.load(std::memory_order_relaxed);
+        size_t n = 0;
+        for (; n < maxCount; ++n) {
+            Cell& cell = fCells[(tail + n) & fMask];
+            if (cell.fSequence.load(std::memory_order_acquire) != tail + n + 1) {
+                break;
+            }
+            T* slot = cell.item();
+            items[n] = std::move(*slot);
+            slot->~T();
+            cell.fSequence.store(tail + n + this->capacity(), std::memory_order_release);
+        }
+        if (n) {
+            fTail.store(tail + n, std::memory_order_release);
+        }
+        return n;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> fSequence;
+        alignas(T) unsigned char fStorage[sizeof(T)];
+
+        T* item() { return std::launder(reinterpret_cast<T*>(fStorage)); }
+    };
+
+    const size_t    fMask;
+    Cell* const     fCells;
+
+    alignas(kEgCacheLineSize) std::atomic<size_t> fHead {0};
+    alignas(kEgCacheLineSize) std::atomic<size_t> fTail {0};
+};
@@ -0,0 +1,590 @@
+#include "src/base/EgUTF.h"
+
+#include "src/base/EgVx.h"
+
+#include <cstring>
+
+using namespace EgUTF;
+
+namespace {
+
+// 按有符号字节比较：SSE2 / NEON 只有有符号的字节比较指令，
+// 80 ~ FF 对应 -128 ~ -1，ASCII 对应非负数。
+using Bytes16 = egvx::Vec<16, int8_t>;
+using Counts16 = egvx::Vec<16, uint8_t>;
+using Units8 = egvx::Vec<8, uint16_t>;
+
+// UTF-16 -> UTF-8 每个单元最多贡献 3 字节，uint16_t 通道最多累计这么多块后汇总
+static constexpr int kMaxUTF16Blocks = 0xFFFF / 3;
+
+/**
+ * @brief 校验从 utf8 开始的一个 UTF-8 序列
+ * @return 序列的字节数，非法或被 stop 截断时返回 -1
+ */
+static int next_sequence_length(const uint8_t* utf8, const uint8_t* stop) {
+    int type = utf8_byte_type(*utf8);
+    if (!utf8_is_valid_leading_byte(type) || utf8 + type > stop) {
+        return -1;
+    }
+    for (int i = 1; i < type; ++i) {
+        if (!utf8_byte_is_continuation(utf8[i])) {
+            return -1;
+        }
+    }
+    if (type > 1 && !utf8_second_byte_is_valid(utf8[0], utf8[1])) {
+        return -1;
+    }
+    return type;
+}
+
+/**
+ * @brief 把每个通道的计数加起来
+ */
+template <int N, typename T>
+static int sum_lanes(const egvx::Vec<N, T>& counts) {
+    T lanes[N];
+    counts.store(lanes);
+    int sum = 0;
+    for (T lane : lanes) {
+        sum += lane;
+    }
+    return sum;
+}
+
+/**
+ * @brief 无符号字节 >= lower（lower >= 0x80）
+ */
+static inline Bytes16 at_least(const Bytes16& v, uint8_t lower) {
+    return (v >= (int8_t)lower) & (v < 0);
+}
+
+/**
+ * 每次处理 16 字节，规则与逐序列的 next_sequence_length 完全一致（比 utf8_byte_type 更严格）：
+ * - C0、C1、F5 ~ FF 不能出现，E0 / ED / F0 / F4 之后的字节受 utf8_second_byte_is_valid 限制；
+ * - 一个字节是后续字节（80 ~ BF），当且仅当它前 1 个字节 >= C0、或前 2 个字节 >= E0、或前 3 个字节 >= F0；
+ * - 合法时字符数等于非后续字节的个数，4 字节序列（F0 ~ F4 开头）对应 BMP 之外的码点。
+ * 块的起点总在序列边界上，因此起点之前的字节不会要求块内出现后续字节；
+ * 块末尾未完成的序列留给下一块，从它的前导字节重新开始。
+ * 纯 ASCII 的块（最常见的情况）只需一次比较。
+ *
+ * @param supplementary 非空时写入 BMP 之外的码点个数（转成 UTF-16 时需要代理对）
+ * @return 码点个数，非法时返回 -1
+ */
+static int count_utf8(const uint8_t* begin, size_t byteLength, int* supplementary) {
+    const uint8_t* const stop = begin + byteLength;
+    const uint8_t* p = begin;
+    int count = 0;
+    int fourByte = 0;
+
+    // 每个通道累计非后续字节数和 4 字节前导字节数，最多累计 255 块后汇总一次以免溢出
+    Counts16 laneCounts(0);
+    Counts16 laneFourByte(0);
+    int blocks = 0;
+
+    while (stop - p >= 16) {
+        // 32 字节用两个 16 字节向量合并判断：没有 AVX 时 32 字节的比较会被拆成逐字节的代码
+        if (stop - p >= 32 && !egvx::any((Bytes16::Load(p) | Bytes16::Load(p + 16)) < 0)) {
+            count += 32;
+            p += 32;
+            continue;
+        }
+        Bytes16 v = Bytes16::Load(p);
+        if (!egvx::any(v < 0)) {
+            count += 16;
+            p += 16;
+            continue;
+        }
+        if (p - begin < 3) {
+            // 向前看 3 个字节会越界，开头几个字节逐个序列处理
+            int length = next_sequence_length(p, stop);
+            if (length < 0) {
+                return -1;
+            }
+            p += length;
+            ++count;
+            fourByte += (length == 4);
+            continue;
+        }
+
+        Bytes16 prev = Bytes16::Load(p - 1);
+        // 有符号比较下 v < (int8_t)0xA0 即无符号的 80 ~ 9F（ASCII 为非负数，不会命中）
+        Bytes16 invalid = (v == (int8_t)0xC0) | (v == (int8_t)0xC1) | at_least(v, 0xF5) |
+                          ((prev == (int8_t)0xE0) & (v < (int8_t)0xA0)) |
+                          ((prev == (int8_t)0xED) & at_least(v, 0xA0)) |
+                          ((prev == (int8_t)0xF0) & (v < (int8_t)0x90)) |
+                          ((prev == (int8_t)0xF4) & at_least(v, 0x90));
+        Bytes16 isContinuation = v < (int8_t)0xC0;
+        Bytes16 needContinuation = at_least(prev, 0xC0) |
+                                   at_least(Bytes16::Load(p - 2), 0xE0) |
+                                   at_least(Bytes16::Load(p - 3), 0xF0);
+        if (egvx::any(invalid | (isContinuation ^ needContinuation))) {
+            return -1;
+        }
+        laneCounts += egvx::bit_pun<Counts16>(~isContinuation & 1);
+        laneFourByte += egvx::bit_pun<Counts16>(at_least(v, 0xF0) & 1);
+
+        // 块内已经校验过，最多只有一个前导字节的序列越过块尾
+        int consumed = 16;
+        for (int k = 1; k <= 3; ++k) {
+            uint8_t c = p[16 - k];
+            if (c >= 0xC0 && utf8_byte_type(c) > k) {
+                consumed = 16 - k;
+                // 该前导字节已计入通道计数，下一块会再计一次
+                --count;
+                fourByte -= (c >= 0xF0);
+                break;
+            }
+        }
+        p += consumed;
+
+        if (++blocks == 255) {
+            count += sum_lanes(laneCounts);
+            fourByte += sum_lanes(laneFourByte);
+            laneCounts = Counts16(0);
+            laneFourByte = Counts16(0);
+            blocks = 0;
+        }
+    }
+    count += sum_lanes(laneCounts);
+    fourByte += sum_lanes(laneFourByte);
+
+    while (p < stop) {
+        int length = next_sequence_length(p, stop);
+        if (length < 0) {
+            return -1;
+        }
+        p += length;
+        ++count;
+        fourByte += (length == 4);
+    }
+    if (supplementary) {
+        *supplementary = fourByte;
+    }
+    return count;
+}
+
+/**
+ * @brief 一个 UTF-16 单元转成 UTF-8 时贡献的字节数，代理项每个计 2 字节（一对共 4 字节）
+ */
+static inline int utf16_unit_utf8_bytes(uint16_t c) {
+    return c < 0x80 ? 1 : (c < 0x800 || (c & 0xF800) == 0xD800) ? 2 : 3;
+}
+
+/**
+ * 合法的 UTF-16 满足：每个位置是后尾代理当且仅当前一个单元是前导代理，且最后一个单元不是前导代理。
+ * 码点个数等于非后尾代理的单元数，因此可以按 8 个单元一块并行校验和统计，不需要按码点切分。
+ *
+ * @param utf8Length 非空时写入转成 UTF-8 需要的字节数
+ * @return 码点个数，非法（孤立的代理项）时返回 -1
+ */
+static int count_utf16(const uint16_t* begin, size_t length, int* utf8Length) {
+    const uint16_t* const stop = begin + length;
+    const uint16_t* p = begin;
+    int count = 0;
+    int bytes = 0;
+
+    // 第一个单元单独处理，之后的块都可以读取前一个单元
+    if (p < stop) {
+        if (utf16_is_low_surrogate(*p)) {
+            return -1;
+        }
+        ++count;
+        bytes += utf16_unit_utf8_bytes(*p);
+        ++p;
+    }
+
+    Units8 laneCounts(0);
+    Units8 laneBytes(0);
+    int blocks = 0;
+    while (stop - p >= 8) {
+        Units8 v = Units8::Load(p);
+        // 全 ASCII 的块里没有后尾代理，前一个单元也就不能是前导代理
+        if (!egvx::any(v >= 0x80) && !utf16_is_high_surrogate(p[-1])) {
+            count += 8;
+            bytes += 8;
+            p += 8;
+            continue;
+        }
+        Units8 isLow = (v & 0xFC00) == 0xDC00;
+        Units8 prevIsHigh = (Units8::Load(p - 1) & 0xFC00) == 0xD800;
+        if (egvx::any(isLow ^ prevIsHigh)) {
+            return -1;
+        }
+        Units8 isSurrogate = (v & 0xF800) == 0xD800;
+        laneCounts += ~isLow & 1;
+        laneBytes += 1 + ((v >= 0x80) & 1) + ((v >= 0x800) & ~isSurrogate & 1);
+        p += 8;
+
+        if (++blocks == kMaxUTF16Blocks) {
+            count += sum_lanes(laneCounts);
+            bytes += sum_lanes(laneBytes);
+            laneCounts = Units8(0);
+            laneBytes = Units8(0);
+            blocks = 0;
+        }
+    }
+    count += sum_lanes(laneCounts);
+    bytes += sum_lanes(laneBytes);
+
+    for (; p < stop; ++p) {
+        bool isLow = utf16_is_low_surrogate(*p);
+        if (isLow != utf16_is_high_surrogate(p[-1])) {
+            return -1;
+        }
+        count += !isLow;
+        bytes += utf16_unit_utf8_bytes(*p);
+    }
+    if (length > 0 && utf16_is_high_surrogate(stop[-1])) {
+        return -1;
+    }
+    if (utf8Length) {
+        *utf8Length = bytes;
+    }
+    return count;
+}
+
+/**
+ * @brief 把 src 写入 dst，超出 dstEnd 的部分丢弃
+ */
+template <typename T>
+static inline void write_clamped(T*& dst, T* dstEnd, const T src[], size_t count) {
+    while (dst < dstEnd && count > 0) {
+        *dst++ = *src++;
+        --count;
+    }
+}
+
+template <typename T>
+static EgUnichar next_fail(const T** ptr, const T* end) {
+    *ptr = end;
+    return -1;
+}
+
+}  // namespace
+
+int EgUTF::CountUTF8(const char* utf8, size_t byteLength) {
+    if (!utf8 && byteLength) {
+        return -1;
+    }
+    return count_utf8((const uint8_t*)utf8, byteLength, nullptr);
+}
+
+int EgUTF::CountUTF16(const char16_t* utf16, size_t charLength) {
+    if (!utf16 && charLength) {
+        return -1;
+    }
+    return count_utf16((const uint16_t*)utf16, charLength, nullptr);
+}
+
+int EgUTF::CountUTF32(const char32_t* utf32, size_t charLength) {
+    if (!utf32 && charLength) {
+        return -1;
+    }
+    for (size_t i = 0; i < charLength; ++i) {
+        if ((uint32_t)utf32[i] > 0x10FFFF) {
+            return -1;
+        }
+    }
+    return (int)charLength;
+}
+
+/**
+ * @brief 解码一个 UTF-8 码点并前移 *ptr，非法时返回 -1 并把 *ptr 移到 end
+ *
+ * hic 把前导字节放在最高位，每左移一位检查一个前导的 1，对应一个后续字节。
+ */
+EgUnichar EgUTF::NextUTF8(const char** ptr, const char* end) {
+    if (!ptr || !end) {
+        return -1;
+    }
+    const uint8_t* p = (const uint8_t*)*ptr;
+    if (!p || p >= (const uint8_t*)end) {
+        return next_fail(ptr, end);
+    }
+    const uint8_t* const lead = p;
+    int c = *p;
+    int hic = left_shift(c, 24);
+
+    if (!utf8_is_valid_leading_byte(utf8_byte_type((uint8_t)c))) {
+        return next_fail(ptr, end);
+    }
+    if (hic < 0) {
+        uint32_t mask = (uint32_t)~0x3F;
+        hic = left_shift(hic, 1);
+        do {
+            ++p;
+            if (p >= (const uint8_t*)end) {
+                return next_fail(ptr, end);
+            }
+            uint8_t nextByte = *p;
+            if (!utf8_byte_is_continuation(nextByte)) {
+                return next_fail(ptr, end);
+            }
+            if (p == lead + 1 && !utf8_second_byte_is_valid(*lead, nextByte)) {
+                return next_fail(ptr, end);
+            }
+            c = (c << 6) | (nextByte & 0x3F);
+            mask <<= 5;
+        } while ((hic = left_shift(hic, 1)) < 0);
+        c &= ~mask;
+    }
+    *ptr = (const char*)p + 1;
+    return c;
+}
+
+EgUnichar EgUTF::NextUTF16(const uint16_t** ptr, const uint16_t* end) {
+    if (!ptr || !end) {
+        return -1;
+    }
+    const uint16_t* src = *ptr;
+    if (!src || src + 1 > end || !is_align2((intptr_t)src)) {
+        return next_fail(ptr, end);
+    }
+    uint16_t c = *src++;
+    EgUnichar result = c;
+    if (utf16_is_low_surrogate(c)) {
+        return next_fail(ptr, end);
+    }
+    if (utf16_is_high_surrogate(c)) {
+        if (src + 1 > end) {
+            return next_fail(ptr, end);
+        }
+        c = *src++;
+        if (!utf16_is_low_surrogate(c)) {
+            return next_fail(ptr, end);
+        }
+        // (high - 0xD800) << 10 + (low - 0xDC00) + 0x10000
+        result = (result << 10) + (EgUnichar)c + (0x10000 - (0xD800 << 10) - 0xDC00);
+    }
+    *ptr = src;
+    return result;
+}
+
+EgUnichar EgUTF::NextUTF32(const uint32_t** ptr, const uint32_t* end) {
+    if (!ptr || !end) {
+        return -1;
+    }
+    const uint32_t* src = *ptr;
+    if (!src || src + 1 > end || !is_align4((intptr_t)src)) {
+        return next_fail(ptr, end);
+    }
+    uint32_t c = *src++;
+    if (c > 0x10FFFF) {
+        return next_fail(ptr, end);
+    }
+    *ptr = src;
+    return (EgUnichar)c;
+}
+
+size_t EgUTF::ToUTF8(EgUnichar unichar, char utf8[kMaxBytesInUTF8Sequence]) {
+    if ((uint32_t)unichar > 0x10FFFF) {
+        return 0;
+    }
+    if (unichar <= 127) {
+        if (utf8) {
+            *utf8 = (char)unichar;
+        }
+        return 1;
+    }
+    char tmp[4];
+    char* p = tmp;
+    size_t count = 1;
+    while (unichar > 0x7F >> count) {
+        *p++ = (char)(0x80 | (unichar & 0x3F));
+        unichar >>= 6;
+        ++count;
+    }
+    if (utf8) {
+        p = tmp;
+        utf8 += count;
+        while (p < tmp + count -1) {
+            *--utf8 = *p++;
+        }
+        *--utf8 = (char)(~(0xFF >> count) | unichar);
+    }
+    return count;
+}
+
+size_t EgUTF::ToUTF16(EgUnichar unichar, uint16_t utf16[2]) {
+    if ((uint32_t)unichar > 0x10FFFF) {
+        return 0;
+    }
+    int extra = (unichar > 0xFFFF);
+    if (utf16) {
+        if (extra) {
+            utf16[0] = (uint16_t)((0xD800 - 64) + (unichar >> 10));
+            utf16[1] = (uint16_t)(0xDC00 | (unichar & 0x3FF));
+        } else {
+            utf16[0] = (uint16_t)unichar;
+        }
+    }
+    return 1 + extra;
+}
+
+
+int EgUTF::UTF8ToUTF16(uint16_t dst[], int dstCapacity, const char src[], size_t srcByteLength) {
+    if (!src && srcByteLength) {
+        return -1;
+    }
+    if (!dst) {
+        int supplementary = 0;
+        int count = count_utf8((const uint8_t*)src, srcByteLength, &supplementary);
+        return count < 0 ? -1 : count + supplementary;
+    }
+
+    uint16_t* const dstEnd = dst + dstCapacity;
+    const char* const srcEnd = src + srcByteLength;
+    int dstLength = 0;
+    while (src < srcEnd) {
+        // ASCII 快速路径：16 字节直接扩展为 16 个单元
+        if (srcEnd - src >= 16 && dstEnd - dst >= 16) {
+            Bytes16 v = Bytes16::Load(src);
+            if (!egvx::any(v < 0)) {
+                egvx::cast<uint16_t>(egvx::bit_pun<Counts16>(v)).store(dst);
+                src += 16;
+                dst += 16;
+                dstLength += 16;
+                continue;
+            }
+        }
+        EgUnichar uni = NextUTF8(&src, srcEnd);
+        if (uni < 0) {
+            return -1;
+        }
+        if (uni < 0x10000) {
+            // BMP 码点只占一个单元
+            if (dst < dstEnd) {
+                *dst++ = (uint16_t)uni;
+            }
+            dstLength += 1;
+        } else {
+            uint16_t utf16[2];
+            size_t count = ToUTF16(uni, utf16);
+            if (count == 0) {
+                return -1;
+            }
+            write_clamped(dst, dstEnd, utf16, count);
+            dstLength += (int)count;
+        }
+    }
+    return dstLength;
+}
+
+int EgUTF::UTF8ToUTF32(EgUnichar dst[], int dstCapacity, const char src[], size_t srcByteLength) {
+    if (!src && srcByteLength) {
+        return -1;
+    }
+    if (!dst) {
+        return count_utf8((const uint8_t*)src, srcByteLength, nullptr);
+    }
+
+    EgUnichar* const dstEnd = dst + dstCapacity;
+    const char* const srcEnd = src + srcByteLength;
+    int dstLength = 0;
+    while (src < srcEnd) {
+        if (srcEnd - src >= 16 && dstEnd - dst >= 16) {
+            Bytes16 v = Bytes16::Load(src);
+            if (!egvx::any(v < 0)) {
+                egvx::cast<int32_t>(egvx::bit_pun<Counts16>(v)).store(dst);
+                src += 16;
+                dst += 16;
+                dstLength += 16;
+                continue;
+            }
+        }
+        EgUnichar uni = NextUTF8(&src, srcEnd);
+        if (uni < 0) {
+            return -1;
+        }
+        if (dst < dstEnd) {
+            *dst++ = uni;
+        }
+        dstLength += 1;
+    }
+    return dstLength;
+}
+
+int EgUTF::UTF16ToUTF8(char dst[], int dstCapacity, const uint16_t src[], int srcCharLength) {
+    if ((!src && srcCharLength) || srcCharLength < 0) {
+        return -1;
+    }
+    if (srcCharLength > 0 && !is_align2((intptr_t)src)) {
+        return -1;
+    }
+    if (!dst) {
+        int utf8Length = 0;
+        return count_utf16(src, srcCharLength, &utf8Length) < 0 ? -1 : utf8Length;
+    }
+
+    char* const dstEnd = dst + dstCapacity;
+    const uint16_t* const srcEnd = src + srcCharLength;
+    int dstLength = 0;
+    while (src < srcEnd) {
+        // ASCII 快速路径：8 个单元直接收窄为 8 字节
+        if (srcEnd - src >= 8 && dstEnd - dst >= 8) {
+            Units8 v = Units8::Load(src);
+            if (!egvx::any(v >= 0x80)) {
+                egvx::cast<uint8_t>(v).store(dst);
+                src += 8;
+                dst += 8;
+                dstLength += 8;
+                continue;
+            }
+        }
+        uint16_t c = *src;
+        char utf8[kMaxBytesInUTF8Sequence];
+        size_t count;
+        if ((c & 0xF800) != 0xD800) {
+            // BMP 码点（非代理项）直接编码，不经过 NextUTF16
+            count = ToUTF8(c, utf8);
+            ++src;
+        } else {
+            EgUnichar uni = NextUTF16(&src, srcEnd);
+            if (uni < 0) {
+                return -1;
+            }
+            count = ToUTF8(uni, utf8);
+        }
+        write_clamped(dst, dstEnd, utf8, count);
+        dstLength += (int)count;
+    }
+    return dstLength;
+}
+
+int EgUTF::UTF16ToUTF32(EgUnichar dst[], int dstCapacity, const uint16_t src[], int srcCharLength) {
+    if ((!src && srcCharLength) || srcCharLength < 0) {
+        return -1;
+    }
+    if (srcCharLength > 0 && !is_align2((intptr_t)src)) {
+        return -1;
+    }
+    if (!dst) {
+        return count_utf16(src, srcCharLength, nullptr);
+    }
+
+    EgUnichar* const dstEnd = dst + dstCapacity;
+    const uint16_t* const srcEnd = src + srcCharLength;
+    int dstLength = 0;
+    while (src < srcEnd) {
+        // BMP 快速路径：8 个单元都不是代理项时逐个扩展
+        if (srcEnd - src >= 8 && dstEnd - dst >= 8) {
+            Units8 v = Units8::Load(src);
+            if (!egvx::any((v & 0xF800) == 0xD800)) {
+                egvx::cast<int32_t>(v).store(dst);
+                src += 8;
+                dst += 8;
+                dstLength += 8;
+                continue;
+            }
+        }
+        EgUnichar uni = NextUTF16(&src, srcEnd);
+        if (uni < 0) {
+            return -1;
+        }
+        if (dst < dstEnd) {
+            *dst++ = uni;
+        }
+        dstLength += 1;
+    }
+    return dstLength;
+}
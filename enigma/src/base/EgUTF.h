@@ -54,7 +54,7 @@ static constexpr inline bool utf16_is_low_surrogate(uint16_t c) {
  * @return 是否是 UTF-8 编码的前导字节
  * @note UTF-8 编码的前导字节范围是 0xC0 ~ 0xFD
  */
-static int utf8_byte_type(uint8_t c) {
+static inline int utf8_byte_type(uint8_t c) {
     if (c < 0x80) {
         return 1;
     } else if (c < 0xC0) {
@@ -67,16 +67,32 @@ static int utf8_byte_type(uint8_t c) {
     }
 }
 
-static bool utf8_is_valid_leading_byte(int type) {
+static inline bool utf8_is_valid_leading_byte(int type) {
     return type > 0;
 }
 
+/**
+ * @brief 多字节序列的第二个字节是否在合法范围内（second 已知是后续字节）
+ *
+ * 排除过长编码（E0 80 ~ 9F、F0 80 ~ 8F）、代理项（ED A0 ~ BF）和超出 U+10FFFF 的码点（F4 90 ~ BF）。
+ * 校验、计数和解码都使用这一条规则，长度查询与实际转换的结果才会一致。
+ */
+static inline bool utf8_second_byte_is_valid(uint8_t lead, uint8_t second) {
+    switch (lead) {
+        case 0xE0: return second >= 0xA0;
+        case 0xED: return second < 0xA0;
+        case 0xF0: return second >= 0x90;
+        case 0xF4: return second < 0x90;
+        default:   return true;
+    }
+}
+
 /**
  * @brief 判断是否是 UTF-8 编码的后续字节
  * @param c 字符
  * @return 是否是 UTF-8 编码的后续字节
  */
-static bool utf8_byte_is_continuation(uint8_t c) {
+static inline bool utf8_byte_is_continuation(uint8_t c) {
     return utf8_byte_type(c) == 0;
 }
 
@@ -86,62 +102,31 @@ static bool utf8_byte_is_continuation(uint8_t c) {
  * @param byteLength 字符串长度
  * @return 字符数
  * @note 如果字符串长度为 0，则返回 0
- * @note 如果字符串长度不为 0，但是字符串不是有效的 UTF-8 编码，则返回 -1
+ * @note 如果字符串长度不为 0，但是字符串不是有效的 UTF-8 编码，则返回 -1；
+ *       过长编码、代理项和超出 U+10FFFF 的序列也视为无效（见 utf8_second_byte_is_valid），
+ *       与各转换函数的规则一致
  */
-EG_API int CountUTF8(const char* utf8, size_t byteLength) {
-    if (!utf8 && byteLength) {
-        return -1;
-    }
-    int count = 0;
-    const char* stop = utf8 + byteLength;
-    while (utf8 < stop) {
-        int type = utf8_byte_type(*(const uint8_t*)utf8);
-        if (!utf8_is_valid_leading_byte(type) || utf8 + type > stop) {
-            return -1;
-        }
-        while(type-- > 1) {
-            ++utf8;
-            if (!utf8_byte_is_continuation(*(const uint8_t*)utf8)) {
-                return -1;
-            }
-        }
-        ++utf8;
-        ++count;
-    }
-    return count;
-}
-
-EG_API int CountUTF16(const char16_t* utf16, size_t charLength) {
-    // TODO
-    return 0;
-}
-
-EG_API int CountUTF32(const char32_t* utf32, size_t charLength) {
-    // TODO
-    return 0;
-}
+EG_API int CountUTF8(const char* utf8, size_t byteLength);
 
-template <typename T>
-static EgUnichar next_fail(const T** ptr, const T* end) {
-    *ptr = end;
-    return -1;
-}
+/**
+ * @brief 计算 UTF-16 编码的字符数，存在孤立的代理项时返回 -1
+ */
+EG_API int CountUTF16(const char16_t* utf16, size_t charLength);
 
-EG_API EgUnichar NextUTF8(const char** ptr, const char* end) {
-    // TODO:
-    return 0;
-}
+/**
+ * @brief 计算 UTF-32 编码的字符数，存在大于 0x10FFFF 的值时返回 -1
+ */
+EG_API int CountUTF32(const char32_t* utf32, size_t charLength);
 
-EG_API EgUnichar NextUTF16(const uint16_t** ptr, const uint16_t* end) {
-    // TODO:
+/**
+ * @brief 解码 *ptr 处的一个码点并前移 *ptr
+ * @return 码点，非法时返回 -1 且 *ptr 被移到 end
+ */
+EG_API EgUnichar NextUTF8(const char** ptr, const char* end);
 
-    return 0;
-}
+EG_API EgUnichar NextUTF16(const uint16_t** ptr, const uint16_t* end);
 
-EG_API EgUnichar NextUTF32(const uint32_t** ptr, const uint32_t* end) {
-    // TODO:
-    return 0;
-}
+EG_API EgUnichar NextUTF32(const uint32_t** ptr, const uint32_t* end);
 
 constexpr unsigned char kMaxBytesInUTF8Sequence = 4;
 
@@ -151,34 +136,7 @@ constexpr unsigned char kMaxBytesInUTF8Sequence = 4;
  * @param utf8 UTF-8 编码
  * @return UTF-8 编码的字节数
  */
-EG_API size_t ToUTF8(EgUnichar unichar, char utf8[kMaxBytesInUTF8Sequence] = nullptr) {
-    if ((uint32_t)unichar > 0x10FFFF) {
-        return 0;
-    }
-    if (unichar <= 127) {
-        if (utf8) {
-            *utf8 = (char)unichar;
-        }
-        return 1;
-    }
-    char tmp[4];
-    char* p = tmp;
-    size_t count = 1;
-    while (unichar > 0x7F >> count) {
-        *p++ = (char)(0x80 | (unichar & 0x3F));
-        unichar >>= 6;
-        ++count;
-    }
-    if (utf8) {
-        p = tmp;
-        utf8 += count;
-        while (p < tmp + count -1) {
-            *--utf8 = *p++;
-        }
-        *--utf8 = (char)(~(0xFF >> count) | unichar);
-    }
-    return count;
-}
+EG_API size_t ToUTF8(EgUnichar unichar, char utf8[kMaxBytesInUTF8Sequence] = nullptr);
 
 /**
  * @brief 将 Unicode 字符转换为 UTF-16 编码
@@ -186,39 +144,20 @@ EG_API size_t ToUTF8(EgUnichar unichar, char utf8[kMaxBytesInUTF8Sequence] = nul
  * @param utf16 UTF-16 编码
  * @return UTF-16 编码的字符数
  */
-EG_API size_t ToUTF16(EgUnichar unichar, uint16_t utf16[2] = nullptr) {
-    if ((uint32_t)unichar > 0x10FFFF) {
-        return 0;
-    }
-    int extra = (unichar > 0xFFFF);
-    if (utf16) {
-        if (extra) {
-            utf16[0] = (uint16_t)((0xD800 - 64) + (unichar >> 10));
-            utf16[1] = (uint16_t)(0xDC00 | (unichar & 0x3FF));
-        } else {
-            utf16[0] = (uint16_t)unichar;
-        }
-    }
-    return 1 + extra;
-}
+EG_API size_t ToUTF16(EgUnichar unichar, uint16_t utf16[2] = nullptr);
 
-EG_API int UTF8ToUTF16(uint16_t* dst, int dstCapacity, const char src[], size_t scrByteLength) {
-    // TODO:
-    return 0;
-}
+/**
+ * 批量转换：dst 为 nullptr 时只校验并返回所需的输出长度（一次扫描即可分配缓冲区）；
+ * 否则写入最多 dstCapacity 个单元，返回值仍是完整的输出长度，调用者据此判断是否被截断。
+ * 输入非法时返回 -1。ASCII（以及 UTF-16 -> UTF-32 的 BMP）连续段按向量处理。
+ */
+EG_API int UTF8ToUTF16(uint16_t dst[], int dstCapacity, const char src[], size_t srcByteLength);
 
+EG_API int UTF8ToUTF32(EgUnichar dst[], int dstCapacity, const char src[], size_t srcByteLength);
 
-EG_API int UTF16ToUTF8(char dst[], int dstCapacity, const uint16_t src[], int srcCharLength) {
-    // TODO: 将 UTF-16 编码的字符串转换为 UTF-8 编码的字符串
-    if (!dst) {
-        dstCapacity = 0;
-    }
-    int dstLength = 0;
-    const char* endDst = dst + dstCapacity;
-    const uint16_t* endSrc = src + srcCharLength;
+EG_API int UTF16ToUTF8(char dst[], int dstCapacity, const uint16_t src[], int srcCharLength);
 
-    return 0;
-}
+EG_API int UTF16ToUTF32(EgUnichar dst[], int dstCapacity, const uint16_t src[], int srcCharLength);
 
 /**
  * @brief 判断是否是 UTF-16 编码的前导代理
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "include/private/base/EgFloatBits.h"
+
 #include <algorithm>         // std::min, std::max
 #include <cassert>           // assert()
 #include <cmath>             // ceilf, floorf, truncf, roundf, sqrtf, etc.
@@ -642,6 +644,40 @@ SIN Vec<N,int> lrint(const Vec<N,float>& x) {
 
 SIN Vec<N,float> fract(const Vec<N,float>& x) { return x - floor(x); }
 
+// approx_erf() is Abramowitz & Stegun 7.1.27, erf(x) ~= 1 - 1/(1 + a1*x + a2*x^2 + a3*x^3 + a4*x^4)^4,
+// extended to negative x by symmetry. Max absolute error is about 5e-4, plenty for coverage.
+SIN Vec<N,float> approx_erf(const Vec<N,float>& x) {
+    Vec<N,uint32_t> bits = bit_pun<Vec<N,uint32_t>>(x),
+                    sign = bits & 0x8000'0000;
+    Vec<N,float> a = bit_pun<Vec<N,float>>(bits ^ sign),
+                 t = 1.0f + a*(0.278393f + a*(0.230389f + a*(0.000972f + a*0.078108f)));
+    t = t*t;
+    t = t*t;
+    Vec<N,float> r = 1.0f - 1.0f/t;
+    return bit_pun<Vec<N,float>>(bit_pun<Vec<N,uint32_t>>(r) | sign);
+}
+
+// approx_log2() / approx_pow2() read the exponent straight out of the float bits (see EgFloatBits.h)
+// and refine it with a rational fit on the mantissa. Relative error is around 1e-4 over the range
+// transfer functions care about, far cheaper than a powf per lane.
+SIN Vec<N,float> approx_log2(const Vec<N,float>& x) {
+    Vec<N,uint32_t> bits = bit_pun<Vec<N,uint32_t>>(x);
+    Vec<N,float> e = cast<float>(bits) * (1.0f / (1 << 23)),
+                 m = bit_pun<Vec<N,float>>((bits & gFloatBits_matissa_mask) | 0x3f00'0000);
+    return e - 124.225514990f - 1.498030302f*m - 1.725879990f/(0.3520887068f + m);
+}
+SIN Vec<N,float> approx_pow2(const Vec<N,float>& x) {
+    // floor() via truncation, fixed up for negative non-integers; avoids a per-lane floorf.
+    Vec<N,float> t = cast<float>(cast<int32_t>(x)),
+                 f = x - if_then_else(t > x, t - 1.0f, t);
+    Vec<N,float> v = (x + 121.274057500f - 1.490129070f*f + 27.728023300f/(4.84252568f - f)) * (1 << 23);
+    return bit_pun<Vec<N,float>>(cast<int32_t>(max(v, 0.0f) + 0.5f));
+}
+// x^y for x >= 0; exact at x == 0 and x == 1 so that black and white survive round trips.
+SIN Vec<N,float> approx_powf(const Vec<N,float>& x, float y) {
+    return if_then_else((x == 0.0f) | (x == 1.0f), x, approx_pow2(approx_log2(x) * y));
+}
+
 // Assumes inputs are finite and treat/flush denorm half floats as/to zero.
 // Key constants to watch for:
 //    - a float is 32-bit, 1-8-23 sign-exponent-mantissa, with 127 exponent bias;
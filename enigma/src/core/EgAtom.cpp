@@ -0,0 +1,177 @@
+#include "include/core/EgAtom.h"
+
+#include "include/core/EgString.h"
+#include "include/private/base/EgAssert.h"
+#include "include/private/base/EgHash.h"
+
+#include "src/base/EgArenaAlloc.h"
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+const EgAtom::Entry EgAtom::gEmptyEntry = {0, 0, {'\0'}};
+
+/**
+ * @brief 全局驻留表
+ *
+ * 按哈希高位分成 kShardCount 个分片，每个分片是一张只增不删的开放寻址表：
+ * - 查找不加锁：槽位是原子指针，条目发布后内容不再改变；
+ * - 插入和扩容持有分片的互斥锁，扩容时新表整体替换旧表，旧表留到进程结束，
+ *   正在读旧表的线程最多查不到新插入的条目，随后会在锁内重新查找。
+ */
+class EgAtomTable {
+public:
+    using Entry = EgAtom::Entry;
+
+    static EgAtomTable& Get() {
+        // 有意泄漏：静态析构之后其他线程仍可能驻留字符串
+        static EgAtomTable* gTable = new EgAtomTable();
+        return *gTable;
+    }
+
+    const Entry* find(const char str[], size_t length, uint32_t hash) const {
+        const Shard& shard = fShards[shard_index(hash)];
+        return Lookup(shard.fTable.load(std::memory_order_acquire), str, length, hash);
+    }
+
+    const Entry* intern(const char str[], size_t length, uint32_t hash) {
+        Shard& shard = fShards[shard_index(hash)];
+        if (const Entry* entry = Lookup(shard.fTable.load(std::memory_order_acquire), str, length, hash)) {
+            return entry;
+        }
+
+        std::lock_guard<std::mutex> lock(shard.fMutex);
+        Table* table = shard.fTable.load(std::memory_order_relaxed);
+        if (const Entry* entry = Lookup(table, str, length, hash)) {
+            return entry;
+        }
+
+        // 负载不超过 1/2，线性探测的探测长度保持很短
+        if ((shard.fCount + 1) * 2 > table->fMask + 1) {
+            table = Grow(&shard, table);
+        }
+
+        EgAssertRelease(length <= UINT32_MAX);
+        void* memory = shard.fAlloc.makeBytesAlignedTo(offsetof(Entry, fData) + length + 1, alignof(Entry));
+        Entry* entry = static_cast<Entry*>(memory);
+        entry->fHash = hash;
+        entry->fLength = (uint32_t)length;
+        memcpy(entry->fData, str, length);
+        entry->fData[length] = '\0';
+
+        Insert(table, entry);
+        shard.fCount++;
+        fTotal.fetch_add(1, std::memory_order_relaxed);
+        return entry;
+    }
+
+    size_t count() const { return fTotal.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr int kShardBits = 4;
+    static constexpr int kShardCount = 1 << kShardBits;
+    static constexpr size_t kInitialSlots = 64;
+
+    struct Table {
+        explicit Table(size_t slots) : fMask(slots - 1), fSlots(new std::atomic<const Entry*>[slots]) {
+            for (size_t i = 0; i < slots; ++i) {
+                fSlots[i].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+
+        const size_t                                    fMask;
+        std::unique_ptr<std::atomic<const Entry*>[]>    fSlots;
+    };
+
+    struct alignas(64) Shard {
+        Shard() : fTable(new Table(kInitialSlots)), fAlloc(4096) {
+            fTables.emplace_back(fTable.load(std::memory_order_relaxed));
+        }
+
+        std::atomic<Table*>                     fTable;
+        std::mutex                              fMutex;
+        size_t                                  fCount = 0;
+        EgArenaAlloc                            fAlloc;
+        std::vector<std::unique_ptr<Table>>     fTables;
+    };
+
+    static int shard_index(uint32_t hash) {
+        return (int)(hash >> (32 - kShardBits));
+    }
+
+    static const Entry* Lookup(const Table* table, const char str[], size_t length, uint32_t hash) {
+        for (size_t i = hash & table->fMask;; i = (i + 1) & table->fMask) {
+            const Entry* entry = table->fSlots[i].load(std::memory_order_acquire);
+            if (entry == nullptr) {
+                return nullptr;
+            }
+            if (entry->fHash == hash && entry->fLength == length && !memcmp(entry->fData, str, length)) {
+                return entry;
+            }
+        }
+    }
+
+    static void Insert(Table* table, const Entry* entry) {
+        size_t i = entry->fHash & table->fMask;
+        while (table->fSlots[i].load(std::memory_order_relaxed) != nullptr) {
+            i = (i + 1) & table->fMask;
+        }
+        // release 保证读到槽位的线程也能看到条目内容
+        table->fSlots[i].store(entry, std::memory_order_release);
+    }
+
+    static Table* Grow(Shard* shard, const Table* oldTable) {
+        size_t slots = (oldTable->fMask + 1) * 2;
+        Table* table = new Table(slots);
+        shard->fTables.emplace_back(table);
+        for (size_t i = 0; i <= oldTable->fMask; ++i) {
+            if (const Entry* entry = oldTable->fSlots[i].load(std::memory_order_relaxed)) {
+                Insert(table, entry);
+            }
+        }
+        shard->fTable.store(table, std::memory_order_release);
+        return table;
+    }
+
+    Shard fShards[kShardCount];
+    std::atomic<size_t> fTotal {0};
+};
+
+static uint32_t hash_atom(const char str[], size_t length) {
+    return (uint32_t)EgHashBytes(str, length);
+}
+
+EgAtom EgAtom::Make(const char str[]) {
+    return Make(str, str ? strlen(str) : 0);
+}
+
+EgAtom EgAtom::Make(const char str[], size_t length) {
+    if (length == 0) {
+        return EgAtom();
+    }
+    return EgAtom(EgAtomTable::Get().intern(str, length, hash_atom(str, length)));
+}
+
+EgAtom EgAtom::Make(const EgString& str) {
+    return Make(str.c_str(), str.size());
+}
+
+bool EgAtom::Find(std::string_view str, EgAtom* atom) {
+    if (str.empty()) {
+        *atom = EgAtom();
+        return true;
+    }
+    const Entry* entry = EgAtomTable::Get().find(str.data(), str.size(), hash_atom(str.data(), str.size()));
+    if (entry == nullptr) {
+        return false;
+    }
+    *atom = EgAtom(entry);
+    return true;
+}
+
+size_t EgAtom::Count() {
+    return EgAtomTable::Get().count();
+}
@@ -1,4 +1,4 @@
-#include "include/core/EgBlendMode.h"
+#include "src/core/EgBlendModePriv.h"
 
 
 bool EgBlendMode_ShouldPreScaleCoverage(EgBlendMode mode, bool rgb_coverage) {
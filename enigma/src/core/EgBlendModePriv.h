@@ -0,0 +1,47 @@
+#pragma once
+
+#include "include/core/EgBlendMode.h"
+
+#include "src/base/EgVx.h"
+
+bool EgBlendMode_ShouldPreScaleCoverage(EgBlendMode mode, bool rgb_coverage);
+
+bool EgBlendMode_SupportsCoverageAsAlpha(EgBlendMode mode);
+
+/**
+ * @brief 计算混合系数
+ * @param coeff 系数类型
+ * @param src 预乘源颜色 (r, g, b, a)
+ * @param dst 预乘目标颜色 (r, g, b, a)
+ */
+static inline egvx::float4 EgBlendModeCoeff_Eval(EgBlendModeCoeff coeff,
+                                                 const egvx::float4& src,
+                                                 const egvx::float4& dst) {
+    switch (coeff) {
+        case EgBlendModeCoeff::gZero:   return egvx::float4(0.0f);
+        case EgBlendModeCoeff::gOne:    return egvx::float4(1.0f);
+        case EgBlendModeCoeff::gSC:     return src;
+        case EgBlendModeCoeff::gISC:    return 1.0f - src;
+        case EgBlendModeCoeff::gDC:     return dst;
+        case EgBlendModeCoeff::gIDC:    return 1.0f - dst;
+        case EgBlendModeCoeff::gSA:     return egvx::float4(src[3]);
+        case EgBlendModeCoeff::gISA:    return egvx::float4(1.0f - src[3]);
+        case EgBlendModeCoeff::gDA:     return egvx::float4(dst[3]);
+        case EgBlendModeCoeff::gIDA:    return egvx::float4(1.0f - dst[3]);
+        default:                        return egvx::float4(0.0f);
+    }
+}
+
+/**
+ * @brief 以系数形式混合两个预乘颜色：result = src * Fs + dst * Fd
+ *
+ * 只支持 mode <= EgBlendMode::gLastCoeffMode，调用者需保证 EgBlendMode_AsCoeff 返回 true。
+ */
+static inline egvx::float4 EgBlendMode_CoeffBlend(EgBlendModeCoeff srcCoeff,
+                                                  EgBlendModeCoeff dstCoeff,
+                                                  const egvx::float4& src,
+                                                  const egvx::float4& dst) {
+    egvx::float4 result = src * EgBlendModeCoeff_Eval(srcCoeff, src, dst) +
+                          dst * EgBlendModeCoeff_Eval(dstCoeff, src, dst);
+    return egvx::pin(result, egvx::float4(0.0f), egvx::float4(1.0f));
+}
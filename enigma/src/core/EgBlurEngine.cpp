@@ -0,0 +1,383 @@
+#include "src/core/EgBlurEngine.h"
+
+#include "include/utils/EgTrace.h"
+
+#include "src/base/EgVx.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+// 一次处理 8 个字节通道：A8 为 8 行，ARGB32 为 2 行。
+using Lanes     = egvx::Vec<8, uint32_t>;
+using LaneBytes = egvx::Vec<8, uint8_t>;
+
+static constexpr int kLaneBytes = 8;
+
+/**
+ * @brief 单趟一维模糊的描述
+ */
+struct BlurPass {
+    enum Type {
+        gIdentity,  // 仅转置
+        gBox,       // 盒式模糊：out[x] = sum(in[x-lo .. x+hi]) / window
+        gGaussian,  // 高斯卷积：out[x] = sum(in[x+k] * weight[k+radius])
+    };
+
+    Type                    fType   = gIdentity;
+    int                     fLo     = 0;
+    int                     fHi     = 0;
+    int                     fWindow = 1;
+    std::vector<uint32_t>   fWeights;   // 16.16 定点权重，和为 65536
+};
+
+/**
+ * @brief 按 W3C Filter Effects 规范计算三次盒式模糊的窗口
+ *
+ * d = floor(σ * 3 * sqrt(2π) / 4 + 0.5)
+ * - d 为奇数：三次以当前像素为中心、宽度为 d 的盒式模糊
+ * - d 为偶数：两次宽度为 d 的盒式模糊（中心分别偏左、偏右半个像素），以及一次宽度为 d+1 的居中模糊
+ */
+static void append_triple_box_passes(float sigma, std::vector<BlurPass>* passes) {
+    int d = (int)floorf(sigma * 3.0f * sqrtf(2.0f * EG_FloatPI) / 4.0f + 0.5f);
+    d = std::max(d, 1);
+
+    auto box = [](int lo, int hi) {
+        BlurPass pass;
+        pass.fType = BlurPass::gBox;
+        pass.fLo = lo;
+        pass.fHi = hi;
+        pass.fWindow = lo + hi + 1;
+        return pass;
+    };
+
+    if (d & 1) {
+        for (int i = 0; i < 3; ++i) {
+            passes->push_back(box((d - 1) / 2, (d - 1) / 2));
+        }
+    } else {
+        passes->push_back(box(d / 2, d / 2 - 1));
+        passes->push_back(box(d / 2 - 1, d / 2));
+        passes->push_back(box(d / 2, d / 2));
+    }
+}
+
+/**
+ * @brief 生成直接高斯卷积核，权重量化为 16.16 定点且和严格为 65536
+ */
+static void append_gaussian_pass(float sigma, std::vector<BlurPass>* passes) {
+    BlurPass pass;
+    pass.fType = BlurPass::gGaussian;
+    int radius = EgBlurEngine::ComputeRadius(sigma);
+    pass.fLo = pass.fHi = radius;
+    pass.fWindow = 2 * radius + 1;
+
+    std::vector<float> weights(pass.fWindow);
+    float denom = 1.0f / (2.0f * sigma * sigma);
+    float total = 0;
+    for (int i = -radius; i <= radius; ++i) {
+        float w = expf(-(float)(i * i) * denom);
+        weights[i + radius] = w;
+        total += w;
+    }
+
+    pass.fWeights.resize(pass.fWindow);
+    uint32_t quantizedTotal = 0;
+    for (int i = 0; i < pass.fWindow; ++i) {
+        pass.fWeights[i] = (uint32_t)lrintf(weights[i] / total * 65536.0f);
+        quantizedTotal += pass.fWeights[i];
+    }
+    // 把量化误差补到中心权重上，保证纯色区域模糊后颜色不变
+    pass.fWeights[radius] += 65536 - quantizedTotal;
+    passes->push_back(std::move(pass));
+}
+
+static void make_passes(float sigma, std::vector<BlurPass>* passes) {
+    switch (EgBlurEngine::ChooseAlgorithm(sigma)) {
+        case EgBlurEngine::Algorithm::gNone:
+            break;
+        case EgBlurEngine::Algorithm::gGaussian:
+            append_gaussian_pass(sigma, passes);
+            break;
+        case EgBlurEngine::Algorithm::gTripleBox:
+        case EgBlurEngine::Algorithm::gDownsample:
+            append_triple_box_passes(sigma, passes);
+            break;
+    }
+}
+
+static void box_kernel(const BlurPass& pass, const Lanes* cols, int width, LaneBytes* out) {
+    // scale 为 1 / window 的 8.24 定点表示：sum <= 255 * window，因此 sum * scale < 2^32
+    const uint32_t scale = (uint32_t)lrint((double)(1 << 24) / pass.fWindow);
+    const int lo = pass.fLo;
+    const int hi = pass.fHi;
+
+    Lanes sum(0);
+    // 预先累加窗口中 x = 0 之前已进入窗口的部分
+    for (int i = 0; i < hi && i < width; ++i) {
+        sum += cols[i];
+    }
+    for (int x = 0; x < width; ++x) {
+        if (x + hi < width) {
+            sum += cols[x + hi];
+        }
+        out[x] = egvx::cast<uint8_t>((sum * scale + (1u << 23)) >> 24);
+        if (x - lo >= 0) {
+            sum -= cols[x - lo];
+        }
+    }
+}
+
+static void gaussian_kernel(const BlurPass& pass, const Lanes* cols, int width, LaneBytes* out) {
+    const int radius = pass.fLo;
+    const uint32_t* weights = pass.fWeights.data();
+    for (int x = 0; x < width; ++x) {
+        int start = std::max(x - radius, 0);
+        int stop  = std::min(x + radius, width - 1);
+        Lanes sum(0);
+        for (int i = start; i <= stop; ++i) {
+            sum += cols[i] * weights[i - x + radius];
+        }
+        out[x] = egvx::cast<uint8_t>((sum + (1u << 15)) >> 16);
+    }
+}
+
+/**
+ * @brief 执行一趟一维模糊，并把结果转置写出
+ *
+ * src 为 height 行、每行 width 个像素；dst 为 width 行、每行 height 个像素。
+ */
+template <int BPP>
+static void transposed_pass(const BlurPass& pass,
+                            const uint8_t* src, size_t srcRowBytes,
+                            int width, int height,
+                            uint8_t* dst, size_t dstRowBytes,
+                            std::vector<Lanes>* colStorage,
+                            std::vector<LaneBytes>* outStorage) {
+    constexpr int kRows = kLaneBytes / BPP;
+
+    colStorage->resize(width);
+    outStorage->resize(width);
+    Lanes* cols = colStorage->data();
+    LaneBytes* out = outStorage->data();
+
+    for (int y = 0; y < height; y += kRows) {
+        const int rows = std::min(kRows, height - y);
+        const uint8_t* rowBase = src + (size_t)y * srcRowBytes;
+
+        // 把 rows 行同一列的像素收集到 8 个通道中
+        for (int x = 0; x < width; ++x) {
+            uint8_t tmp[kLaneBytes] = {0};
+            for (int r = 0; r < rows; ++r) {
+                memcpy(tmp + r * BPP, rowBase + r * srcRowBytes + x * BPP, BPP);
+            }
+            cols[x] = egvx::cast<uint32_t>(LaneBytes::Load(tmp));
+        }
+
+        switch (pass.fType) {
+            case BlurPass::gIdentity:
+                for (int x = 0; x < width; ++x) {
+                    out[x] = egvx::cast<uint8_t>(cols[x]);
+                }
+                break;
+            case BlurPass::gBox:
+                box_kernel(pass, cols, width, out);
+                break;
+            case BlurPass::gGaussian:
+                gaussian_kernel(pass, cols, width, out);
+                break;
+        }
+
+        // 转置写出：第 x 列成为目标的第 x 行，这 rows * BPP 个字节在目标行中是连续的
+        uint8_t* dstCol = dst + (size_t)y * BPP;
+        if (rows == kRows) {
+            for (int x = 0; x < width; ++x) {
+                out[x].store(dstCol + (size_t)x * dstRowBytes);
+            }
+        } else {
+            for (int x = 0; x < width; ++x) {
+                uint8_t tmp[kLaneBytes];
+                out[x].store(tmp);
+                memcpy(dstCol + (size_t)x * dstRowBytes, tmp, rows * BPP);
+            }
+        }
+    }
+}
+
+/**
+ * @brief 在 image（height 行 width 列）上原地执行 X、Y 两个方向的多趟模糊
+ *
+ * 每一轮先做一趟 X（写入转置缓冲），再做一趟 Y（转置写回），
+ * 盒式模糊满足交换律，所以 X/Y 交错执行与先 X 后 Y 结果相同。
+ */
+template <int BPP>
+static void blur_passes(uint8_t* image, size_t rowBytes, int width, int height,
+                        const std::vector<BlurPass>& passesX,
+                        const std::vector<BlurPass>& passesY) {
+    const size_t rounds = std::max(passesX.size(), passesY.size());
+    if (rounds == 0) {
+        return;
+    }
+
+    const size_t transposedRowBytes = (size_t)height * BPP;
+    std::vector<uint8_t> transposed(transposedRowBytes * width);
+    std::vector<Lanes> cols;
+    std::vector<LaneBytes> out;
+
+    const BlurPass identity;
+    for (size_t i = 0; i < rounds; ++i) {
+        const BlurPass& px = i < passesX.size() ? passesX[i] : identity;
+        const BlurPass& py = i < passesY.size() ? passesY[i] : identity;
+        transposed_pass<BPP>(px, image, rowBytes, width, height,
+                             transposed.data(), transposedRowBytes, &cols, &out);
+        transposed_pass<BPP>(py, transposed.data(), transposedRowBytes, height, width,
+                             image, rowBytes, &cols, &out);
+    }
+}
+
+/**
+ * @brief 按 scale x scale 的块取平均做降采样（越界部分视为 0）
+ */
+template <int BPP>
+static void downsample(const uint8_t* src, size_t srcRowBytes, int srcW, int srcH,
+                       int scale, uint8_t* dst, size_t dstRowBytes, int dstW, int dstH) {
+    const uint32_t area = (uint32_t)(scale * scale);
+    std::vector<uint32_t> accum((size_t)dstW * BPP);
+    for (int y = 0; y < dstH; ++y) {
+        std::fill(accum.begin(), accum.end(), 0);
+        for (int sy = y * scale; sy < std::min((y + 1) * scale, srcH); ++sy) {
+            const uint8_t* row = src + (size_t)sy * srcRowBytes;
+            for (int sx = 0; sx < srcW; ++sx) {
+                uint32_t* acc = accum.data() + (size_t)(sx / scale) * BPP;
+                for (int c = 0; c < BPP; ++c) {
+                    acc[c] += row[sx * BPP + c];
+                }
+            }
+        }
+        uint8_t* dstRow = dst + (size_t)y * dstRowBytes;
+        for (size_t i = 0; i < accum.size(); ++i) {
+            dstRow[i] = (uint8_t)((accum[i] + area / 2) / area);
+        }
+    }
+}
+
+/**
+ * @brief 双线性升采样，目标像素中心映射到源图 (x + 0.5) / scale - 0.5
+ */
+template <int BPP>
+static void upsample(const uint8_t* src, size_t srcRowBytes, int srcW, int srcH,
+                     int scale, uint8_t* dst, size_t dstRowBytes, int dstW, int dstH) {
+    const float invScale = 1.0f / scale;
+    for (int y = 0; y < dstH; ++y) {
+        float fy = (y + 0.5f) * invScale - 0.5f;
+        int y0 = (int)floorf(fy);
+        float ty = fy - y0;
+        int y1 = std::min(y0 + 1, srcH - 1);
+        y0 = std::max(y0, 0);
+        const uint8_t* row0 = src + (size_t)y0 * srcRowBytes;
+        const uint8_t* row1 = src + (size_t)y1 * srcRowBytes;
+        uint8_t* dstRow = dst + (size_t)y * dstRowBytes;
+
+        for (int x = 0; x < dstW; ++x) {
+            float fx = (x + 0.5f) * invScale - 0.5f;
+            int x0 = (int)floorf(fx);
+            float tx = fx - x0;
+            int x1 = std::min(x0 + 1, srcW - 1);
+            x0 = std::max(x0, 0);
+            for (int c = 0; c < BPP; ++c) {
+                float top = row0[x0 * BPP + c] + (row0[x1 * BPP + c] - row0[x0 * BPP + c]) * tx;
+                float bot = row1[x0 * BPP + c] + (row1[x1 * BPP + c] - row1[x0 * BPP + c]) * tx;
+                dstRow[x * BPP + c] = (uint8_t)lrintf(top + (bot - top) * ty);
+            }
+        }
+    }
+}
+
+template <int BPP>
+static bool blur_image(uint8_t* image, size_t rowBytes, int width, int height,
+                       float sigmaX, float sigmaY) {
+    // 降采样倍数取 2 的幂，保证 sigma / scale 落在盒式模糊的范围内
+    int scale = 1;
+    while (std::max(sigmaX, sigmaY) / scale > EgBlurEngine::kMaxBoxSigma) {
+        scale *= 2;
+    }
+
+    std::vector<BlurPass> passesX, passesY;
+    make_passes(sigmaX / scale, &passesX);
+    make_passes(sigmaY / scale, &passesY);
+
+    if (scale == 1) {
+        blur_passes<BPP>(image, rowBytes, width, height, passesX, passesY);
+        return true;
+    }
+
+    const int smallW = (width  + scale - 1) / scale;
+    const int smallH = (height + scale - 1) / scale;
+    const size_t smallRowBytes = (size_t)smallW * BPP;
+    std::vector<uint8_t> small(smallRowBytes * smallH);
+
+    downsample<BPP>(image, rowBytes, width, height, scale, small.data(), smallRowBytes, smallW, smallH);
+    blur_passes<BPP>(small.data(), smallRowBytes, smallW, smallH, passesX, passesY);
+    upsample<BPP>(small.data(), smallRowBytes, smallW, smallH, scale, image, rowBytes, width, height);
+    return true;
+}
+
+}  // namespace
+
+EgBlurEngine::Algorithm EgBlurEngine::ChooseAlgorithm(float sigma) {
+    if (!(sigma >= kMinSigma)) {
+        return Algorithm::gNone;
+    }
+    if (sigma <= kMaxDirectSigma) {
+        return Algorithm::gGaussian;
+    }
+    if (sigma <= kMaxBoxSigma) {
+        return Algorithm::gTripleBox;
+    }
+    return Algorithm::gDownsample;
+}
+
+int EgBlurEngine::ComputeRadius(float sigma) {
+    if (ChooseAlgorithm(sigma) == Algorithm::gNone) {
+        return 0;
+    }
+    return EgScalarCeilToInt(3.0f * sigma);
+}
+
+bool EgBlurEngine::Blur(const EgMask& src, float sigmaX, float sigmaY, EgMask* dst) {
+    EgAssert(dst != nullptr);
+    if (src.fImage == nullptr || src.isEmpty() || !EgScalarIsFinite(sigmaX) || !EgScalarIsFinite(sigmaY)) {
+        return false;
+    }
+
+    EG_TRACE_EVENT1("raster", "EgBlurEngine::Blur", "pixels", (int64_t)src.fBounds.width() * src.fBounds.height());
+
+    const int rx = ComputeRadius(sigmaX);
+    const int ry = ComputeRadius(sigmaY);
+
+    dst->fFormat = src.fFormat;
+    dst->fBounds = src.fBounds;
+    dst->fBounds.outset(rx, ry);
+    if (!dst->allocImage()) {
+        return false;
+    }
+
+    // 把源图拷贝到带边距的输出缓冲中心，边距部分为 0
+    const int bpp = src.bytesPerPixel();
+    const size_t srcRowLen = (size_t)src.fBounds.width() * bpp;
+    for (int y = 0; y < src.fBounds.height(); ++y) {
+        memcpy(dst->fImage + (size_t)(y + ry) * dst->fRowBytes + (size_t)rx * bpp,
+               src.fImage + (size_t)y * src.fRowBytes,
+               srcRowLen);
+    }
+
+    const int width  = dst->fBounds.width();
+    const int height = dst->fBounds.height();
+    if (src.fFormat == EgMask::gARGB32_Format) {
+        return blur_image<4>(dst->fImage, dst->fRowBytes, width, height, sigmaX, sigmaY);
+    }
+    return blur_image<1>(dst->fImage, dst->fRowBytes, width, height, sigmaX, sigmaY);
+}
@@ -0,0 +1,145 @@
+#include "src/core/EgBlurMask.h"
+
+#include "include/utils/EgTrace.h"
+
+#include "src/base/EgVx.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+using float8 = egvx::float8;
+
+static constexpr int kLanes = 8;
+
+// Y 方向的高斯加权采样数，4 个采样的覆盖率误差约为 3/255，对阴影来说足够
+static constexpr int kRRectYSamples = 4;
+
+static const float8 kIota = {0, 1, 2, 3, 4, 5, 6, 7};
+
+static int round_up_lanes(int count) {
+    return (count + kLanes - 1) & ~(kLanes - 1);
+}
+
+/**
+ * @brief 一维区间 [lo, hi] 经过高斯模糊后在各像素中心处的覆盖率
+ *
+ * out[i] = (erf((c - lo) * k) - erf((c - hi) * k)) / 2，其中 c = start + i + 0.5，k = 1 / (σ√2)。
+ * out 的长度需向上取整到 8 的倍数。
+ */
+static void compute_profile(float lo, float hi, int start, int count, float k, float* out) {
+    for (int i = 0; i < count; i += kLanes) {
+        float8 c = kIota + (float)(start + i) + 0.5f;
+        float8 v = 0.5f * (egvx::approx_erf((c - lo) * k) - egvx::approx_erf((c - hi) * k));
+        v.store(out + i);
+    }
+}
+
+static void store_coverage(const float8& coverage, uint8_t* dst, int remaining) {
+    float8 scaled = egvx::min(egvx::max(coverage * 255.0f + 0.5f, 0.0f), 255.0f);
+    egvx::Vec<8, uint8_t> bytes = egvx::cast<uint8_t>(egvx::cast<int32_t>(scaled));
+    if (remaining >= kLanes) {
+        bytes.store(dst);
+    } else {
+        uint8_t tmp[kLanes];
+        bytes.store(tmp);
+        std::copy(tmp, tmp + remaining, dst);
+    }
+}
+
+static bool alloc_blurred_bounds(EgScalar sigma, const EgRect& src, EgMask* dst) {
+    if (!(sigma > 0) || !EgScalarIsFinite(sigma) || !src.isFinite() || src.isEmpty()) {
+        return false;
+    }
+    EgScalar pad = 3.0f * sigma;
+    EgRect bounds = src.makeOutset(pad, pad);
+    dst->fFormat = EgMask::gA8_Format;
+    bounds.roundOut(&dst->fBounds);
+    return dst->allocImage();
+}
+
+}  // namespace
+
+bool EgBlurMask::BlurRect(EgScalar sigma, EgMask* dst, const EgRect& src) {
+    EG_TRACE_EVENT("raster", "EgBlurMask::BlurRect");
+    if (!alloc_blurred_bounds(sigma, src, dst)) {
+        return false;
+    }
+
+    const int width  = dst->fBounds.width();
+    const int height = dst->fBounds.height();
+    const float k = 1.0f / (sigma * EG_FloatSqrt2);
+
+    // 矩形的模糊结果可分离：coverage(x, y) = profileX(x) * profileY(y)
+    std::vector<float> profileX(round_up_lanes(width));
+    std::vector<float> profileY(round_up_lanes(height));
+    compute_profile(src.fLeft, src.fRight,  dst->fBounds.fLeft, width,  k, profileX.data());
+    compute_profile(src.fTop,  src.fBottom, dst->fBounds.fTop,  height, k, profileY.data());
+
+    for (int y = 0; y < height; ++y) {
+        uint8_t* row = dst->fImage + (size_t)y * dst->fRowBytes;
+        const float py = profileY[y];
+        for (int x = 0; x < width; x += kLanes) {
+            store_coverage(float8::Load(profileX.data() + x) * py, row + x, width - x);
+        }
+    }
+    return true;
+}
+
+bool EgBlurMask::BlurRRect(EgScalar sigma, EgMask* dst, const EgRect& src, EgScalar radius) {
+    const EgScalar halfW = src.width()  * 0.5f;
+    const EgScalar halfH = src.height() * 0.5f;
+    radius = std::min(std::max(radius, 0.0f), std::min(halfW, halfH));
+    if (radius <= 0) {
+        return BlurRect(sigma, dst, src);
+    }
+    if (!alloc_blurred_bounds(sigma, src, dst)) {
+        return false;
+    }
+    EG_TRACE_EVENT("raster", "EgBlurMask::BlurRRect");
+
+    const int width  = dst->fBounds.width();
+    const int height = dst->fBounds.height();
+    const float k = 1.0f / (sigma * EG_FloatSqrt2);
+    const float gaussianScale = 1.0f / (sigma * sqrtf(2.0f * EG_FloatPI));
+    const float cx = src.centerX();
+    const float cy = src.centerY();
+
+    for (int y = 0; y < height; ++y) {
+        uint8_t* row = dst->fImage + (size_t)y * dst->fRowBytes;
+        const float py = dst->fBounds.fTop + y + 0.5f - cy;
+
+        // 在 Y 方向对 [-3σ, 3σ] 与圆角矩形相交的部分做中点采样，
+        // 每个采样行上圆角矩形的半宽 curved 只依赖 y，在行内是常量。
+        const float start = std::min(std::max(-3.0f * sigma, py - halfH), py + halfH);
+        const float end   = std::min(std::max( 3.0f * sigma, py - halfH), py + halfH);
+        const float step  = (end - start) / kRRectYSamples;
+        if (step <= 0) {
+            continue;
+        }
+
+        float weights[kRRectYSamples];
+        float curved[kRRectYSamples];
+        for (int s = 0; s < kRRectYSamples; ++s) {
+            float ys = start + step * (s + 0.5f);
+            weights[s] = expf(-ys * ys / (2.0f * sigma * sigma)) * gaussianScale * step;
+
+            float delta = std::min(halfH - radius - fabsf(py - ys), 0.0f);
+            curved[s] = halfW - radius + sqrtf(std::max(0.0f, radius * radius - delta * delta));
+        }
+
+        for (int x = 0; x < width; x += kLanes) {
+            float8 px = kIota + (float)(dst->fBounds.fLeft + x) + (0.5f - cx);
+            float8 coverage(0.0f);
+            for (int s = 0; s < kRRectYSamples; ++s) {
+                float8 integral = egvx::approx_erf((px + curved[s]) * k) -
+                                  egvx::approx_erf((px - curved[s]) * k);
+                coverage += integral * (0.5f * weights[s]);
+            }
+            store_coverage(coverage, row + x, width - x);
+        }
+    }
+    return true;
+}
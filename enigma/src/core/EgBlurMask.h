@@ -0,0 +1,30 @@
+#pragma once
+
+#include "include/core/EgRect.h"
+#include "include/core/EgScalar.h"
+
+#include "src/core/EgMask.h"
+
+/**
+ * @brief 矩形与圆角矩形模糊遮罩的解析计算
+ *
+ * 高斯模糊后的矩形可以分离为 X、Y 两个方向误差函数之差的乘积，
+ * 圆角矩形则对每一行在 Y 方向做少量高斯加权采样、在 X 方向解析积分。
+ * 两者都不需要先光栅化再做模糊，代价只和输出像素数成正比。
+ */
+class EgBlurMask {
+public:
+    /**
+     * @brief 计算 gNormal_EgBlurStyle 模糊后的矩形遮罩
+     * @param sigma 高斯分布标准差，必须 > 0
+     * @param dst 输出 A8 遮罩，fBounds 为 src 外扩 3σ 后取整，图像内存由本函数分配
+     * @param src 设备空间中的矩形
+     */
+    static bool BlurRect(EgScalar sigma, EgMask* dst, const EgRect& src);
+
+    /**
+     * @brief 计算 gNormal_EgBlurStyle 模糊后的圆角矩形遮罩（四个角半径相同）
+     * @param radius 圆角半径，会被限制在 [0, min(width, height) / 2] 范围内
+     */
+    static bool BlurRRect(EgScalar sigma, EgMask* dst, const EgRect& src, EgScalar radius);
+};
@@ -0,0 +1,122 @@
+#include "src/core/EgBlurMaskFilter.h"
+
+#include "src/core/EgBlurEngine.h"
+#include "src/core/EgBlurMask.h"
+#include "src/core/EgFrameStatsPriv.h"
+#include "src/base/EgVx.h"
+
+#include <cstring>
+
+namespace {
+
+using Bytes16 = egvx::Vec<16, uint8_t>;
+
+/**
+ * @brief 按模糊样式把原始遮罩与模糊结果合成到 blur 中
+ *
+ * blur 的边界包含 src 的边界。
+ * - gSolid : blur = src + blur * (1 - src)
+ * - gOuter : blur = blur * (1 - src)
+ * - gInner : 由调用者裁剪到 src 边界，blur = blur * src
+ */
+static void merge_src_with_blur(const EgMask& src, EgMask* blur, EgBlurStyle style) {
+    const int width = src.fBounds.width();
+    for (int y = src.fBounds.fTop; y < src.fBounds.fBottom; ++y) {
+        const uint8_t* s = src.getAddr(src.fBounds.fLeft, y);
+        uint8_t* d = blur->getAddr(src.fBounds.fLeft, y);
+
+        int x = 0;
+        for (; x + 16 <= width; x += 16) {
+            Bytes16 sv = Bytes16::Load(s + x);
+            Bytes16 dv = Bytes16::Load(d + x);
+            Bytes16 inv = Bytes16(255) - sv;
+            switch (style) {
+                case gSolid_EgBlurStyle: dv = sv + egvx::approx_scale(dv, inv); break;
+                case gOuter_EgBlurStyle: dv = egvx::approx_scale(dv, inv);      break;
+                case gInner_EgBlurStyle: dv = egvx::approx_scale(dv, sv);       break;
+                default: break;
+            }
+            dv.store(d + x);
+        }
+        for (; x < width; ++x) {
+            unsigned sv = s[x];
+            unsigned dv = d[x];
+            switch (style) {
+                case gSolid_EgBlurStyle: dv = sv + ((dv * (255 - sv) + dv) >> 8); break;
+                case gOuter_EgBlurStyle: dv = (dv * (255 - sv) + dv) >> 8;        break;
+                case gInner_EgBlurStyle: dv = (dv * sv + dv) >> 8;                break;
+                default: break;
+            }
+            d[x] = (uint8_t)dv;
+        }
+    }
+}
+
+}  // namespace
+
+EgBlurMaskFilterImpl::EgBlurMaskFilterImpl(EgScalar sigma, EgBlurStyle style)
+    : fSigma(sigma)
+    , fBlurStyle(style) {
+    EgAssert(sigma > 0);
+    EgAssert((unsigned)style <= gLastEnum_EgBlurStyle);
+}
+
+EgRect EgBlurMaskFilterImpl::approximateFilteredBounds(const EgRect& src) const {
+    EgScalar pad = 3.0f * fSigma;
+    return src.makeOutset(pad, pad);
+}
+
+bool EgBlurMaskFilterImpl::filterMask(EgMask* dst, const EgMask& src) const {
+    if (src.fFormat != EgMask::gA8_Format) {
+        return false;
+    }
+    EgFrameStats_AddDraw(gMaskFilter_EgDrawType);
+
+    EgMask blur;
+    if (!EgBlurEngine::Blur(src, fSigma, fSigma, &blur)) {
+        return false;
+    }
+    EgAutoMaskFreeImage autoBlur(blur.fImage);
+
+    if (fBlurStyle != gNormal_EgBlurStyle) {
+        merge_src_with_blur(src, &blur, fBlurStyle);
+    }
+
+    if (fBlurStyle == gInner_EgBlurStyle) {
+        // 内部模糊只保留源遮罩范围内的部分
+        dst->fFormat = EgMask::gA8_Format;
+        dst->fBounds = src.fBounds;
+        if (!dst->allocImage()) {
+            return false;
+        }
+        for (int y = src.fBounds.fTop; y < src.fBounds.fBottom; ++y) {
+            memcpy(dst->getAddr(src.fBounds.fLeft, y),
+                   blur.getAddr(src.fBounds.fLeft, y),
+                   src.fBounds.width());
+        }
+        return true;
+    }
+
+    *dst = blur;
+    autoBlur.release();
+    return true;
+}
+
+bool EgBlurMaskFilterImpl::filterRRectMask(EgMask* dst, const EgRect& rect, EgScalar cornerRadius) const {
+    // 其余样式需要原始遮罩参与合成，交给 filterMask 处理
+    if (fBlurStyle != gNormal_EgBlurStyle) {
+        return false;
+    }
+    EgFrameStats_AddDraw(gRRectMaskFilter_EgDrawType);
+    return EgBlurMask::BlurRRect(fSigma, dst, rect, cornerRadius);
+}
+
+EgSp<EgMaskFilter> EgMaskFilter::MakeBlur(EgBlurStyle style, EgScalar sigma) {
+    if (!EgScalarIsFinite(sigma) || sigma <= 0) {
+        return nullptr;
+    }
+    if ((unsigned)style > gLastEnum_EgBlurStyle) {
+        return nullptr;
+    }
+    return EgMakeSp<EgBlurMaskFilterImpl>(sigma, style);
+}
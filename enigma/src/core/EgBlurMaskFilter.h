@@ -0,0 +1,24 @@
+#pragma once
+
+#include "include/core/EgBlurTypes.h"
+#include "include/core/EgScalar.h"
+
+#include "src/core/EgMaskFilterBase.h"
+
+class EgBlurMaskFilterImpl : public EgMaskFilterBase {
+public:
+    EgBlurMaskFilterImpl(EgScalar sigma, EgBlurStyle style);
+
+    EgRect approximateFilteredBounds(const EgRect& src) const override;
+
+    bool filterMask(EgMask* dst, const EgMask& src) const override;
+
+    bool filterRRectMask(EgMask* dst, const EgRect& rect, EgScalar cornerRadius) const override;
+
+    EgScalar sigma() const { return fSigma; }
+    EgBlurStyle blurStyle() const { return fBlurStyle; }
+
+private:
+    const EgScalar      fSigma;
+    const EgBlurStyle   fBlurStyle;
+};
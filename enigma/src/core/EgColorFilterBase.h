@@ -0,0 +1,24 @@
+#pragma once
+
+#include "include/core/EgColorFilter.h"
+
+#include "src/core/EgRasterPipeline.h"
+
+class EgColorFilterBase : public EgColorFilter {
+public:
+    /**
+     * @brief 把滤镜作为若干阶段追加到光栅流水线中
+     *
+     * 进入与离开这些阶段时，流水线中的颜色都是预乘的。需要的上下文由滤镜自身持有，
+     * 因此滤镜的生命周期需覆盖流水线的执行。
+     */
+    virtual void appendStages(EgRasterPipeline* pipeline) const = 0;
+};
+
+static inline EgColorFilterBase* as_CFB(EgColorFilter* cf) {
+    return static_cast<EgColorFilterBase*>(cf);
+}
+
+static inline const EgColorFilterBase* as_CFB(const EgColorFilter* cf) {
+    return static_cast<const EgColorFilterBase*>(cf);
+}
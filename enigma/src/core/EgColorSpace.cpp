@@ -0,0 +1,166 @@
+#include "include/core/EgColorSpace.h"
+
+#include "include/core/EgScalar.h"
+
+#include <cmath>
+#include <cstring>
+
+bool EgTransferFunction::invert(EgTransferFunction* inverse) const {
+    if (fType != gParametric) {
+        return false;
+    }
+    // 曲线段 y = (a*x + b)^g + e 的逆为 x = (A*y + B)^G + E：
+    //   A = a^-g，B = -e * a^-g，G = 1/g，E = -b/a
+    // 线性段 y = c*x + f 的逆为 x = y/c - f/c，分段点变为 c*d + f
+    if (g == 0 || a == 0 || !EgScalarIsFinite(g) || !EgScalarIsFinite(a)) {
+        return false;
+    }
+    EgTransferFunction inv;
+    inv.fType = gParametric;
+    const float k = powf(a, -g);
+    inv.g = 1.0f / g;
+    inv.a = k;
+    inv.b = -e * k;
+    inv.e = -b / a;
+    if (d > 0) {
+        if (c == 0) {
+            return false;
+        }
+        inv.c = 1.0f / c;
+        inv.f = -f / c;
+        inv.d = c * d + f;
+    } else {
+        inv.c = 0;
+        inv.f = 0;
+        inv.d = 0;
+    }
+    *inverse = inv;
+    return true;
+}
+
+bool EgTransferFunction::operator==(const EgTransferFunction& other) const {
+    if (fType != other.fType) {
+        return false;
+    }
+    if (fType != gParametric) {
+        return true;
+    }
+    return g == other.g && a == other.a && b == other.b && c == other.c &&
+           d == other.d && e == other.e && f == other.f;
+}
+
+////////////////////////////////////////////////////////
+
+bool EgColorMatrix3x3::operator==(const EgColorMatrix3x3& other) const {
+    return EgScalarsEqual(&vals[0][0], &other.vals[0][0], 9);
+}
+
+bool EgColorMatrix3x3::invert(EgColorMatrix3x3* inverse) const {
+    const auto& m = vals;
+    double a00 = (double)m[1][1] * m[2][2] - (double)m[1][2] * m[2][1];
+    double a01 = (double)m[0][2] * m[2][1] - (double)m[0][1] * m[2][2];
+    double a02 = (double)m[0][1] * m[1][2] - (double)m[0][2] * m[1][1];
+    double a10 = (double)m[1][2] * m[2][0] - (double)m[1][0] * m[2][2];
+    double a11 = (double)m[0][0] * m[2][2] - (double)m[0][2] * m[2][0];
+    double a12 = (double)m[0][2] * m[1][0] - (double)m[0][0] * m[1][2];
+    double a20 = (double)m[1][0] * m[2][1] - (double)m[1][1] * m[2][0];
+    double a21 = (double)m[0][1] * m[2][0] - (double)m[0][0] * m[2][1];
+    double a22 = (double)m[0][0] * m[1][1] - (double)m[0][1] * m[1][0];
+
+    double det = m[0][0] * a00 + m[0][1] * a10 + m[0][2] * a20;
+    if (det == 0 || !std::isfinite(det)) {
+        return false;
+    }
+    double invDet = 1.0 / det;
+    EgColorMatrix3x3 inv = {{
+        { (float)(a00 * invDet), (float)(a01 * invDet), (float)(a02 * invDet) },
+        { (float)(a10 * invDet), (float)(a11 * invDet), (float)(a12 * invDet) },
+        { (float)(a20 * invDet), (float)(a21 * invDet), (float)(a22 * invDet) },
+    }};
+    if (!EgScalarsAreFinite(&inv.vals[0][0], 9)) {
+        return false;
+    }
+    *inverse = inv;
+    return true;
+}
+
+EgColorMatrix3x3 EgColorMatrix3x3::Concat(const EgColorMatrix3x3& a, const EgColorMatrix3x3& b) {
+    EgColorMatrix3x3 result;
+    for (int r = 0; r < 3; ++r) {
+        for (int c = 0; c < 3; ++c) {
+            result.vals[r][c] = a.vals[r][0] * b.vals[0][c] +
+                                a.vals[r][1] * b.vals[1][c] +
+                                a.vals[r][2] * b.vals[2][c];
+        }
+    }
+    return result;
+}
+
+////////////////////////////////////////////////////////
+
+static bool is_finite(const EgTransferFunction& tf) {
+    const float params[] = { tf.g, tf.a, tf.b, tf.c, tf.d, tf.e, tf.f };
+    return EgScalarsAreFinite(params, 7);
+}
+
+EgColorSpace::EgColorSpace(const EgTransferFunction& transferFn, const EgColorMatrix3x3& toXYZD50)
+    : fTransferFn(transferFn)
+    , fInvTransferFn(transferFn)
+    , fToXYZD50(toXYZD50) {
+    if (transferFn.fType == EgTransferFunction::gParametric) {
+        transferFn.invert(&fInvTransferFn);
+    }
+    toXYZD50.invert(&fFromXYZD50);
+}
+
+EgSp<EgColorSpace> EgColorSpace::MakeSRGB() {
+    static const EgSp<EgColorSpace> gSRGB =
+            EgMakeSp<EgColorSpace>(EgNamedTransferFn::gSRGB, EgNamedGamut::gSRGB);
+    return gSRGB;
+}
+
+EgSp<EgColorSpace> EgColorSpace::MakeSRGBLinear() {
+    static const EgSp<EgColorSpace> gSRGBLinear =
+            EgMakeSp<EgColorSpace>(EgNamedTransferFn::gLinear, EgNamedGamut::gSRGB);
+    return gSRGBLinear;
+}
+
+EgSp<EgColorSpace> EgColorSpace::MakeRGB(const EgTransferFunction& transferFn,
+                                                    const EgColorMatrix3x3& toXYZD50) {
+    EgColorMatrix3x3 fromXYZ;
+    if (!toXYZD50.invert(&fromXYZ)) {
+        return nullptr;
+    }
+    if (transferFn.fType == EgTransferFunction::gParametric) {
+        EgTransferFunction inv;
+        if (transferFn.g <= 0 || !is_finite(transferFn) || !transferFn.invert(&inv) || !is_finite(inv)) {
+            return nullptr;
+        }
+    }
+    if (transferFn == EgNamedTransferFn::gSRGB && toXYZD50 == EgNamedGamut::gSRGB) {
+        return MakeSRGB();
+    }
+    if (transferFn == EgNamedTransferFn::gLinear && toXYZD50 == EgNamedGamut::gSRGB) {
+        return MakeSRGBLinear();
+    }
+    return EgMakeSp<EgColorSpace>(transferFn, toXYZD50);
+}
+
+bool EgColorSpace::isSRGB() const {
+    return fTransferFn == EgNamedTransferFn::gSRGB && fToXYZD50 == EgNamedGamut::gSRGB;
+}
+
+bool EgColorSpace::gammaIsLinear() const {
+    return fTransferFn == EgNamedTransferFn::gLinear;
+}
+
+bool EgColorSpace::Equals(const EgColorSpace* a, const EgColorSpace* b) {
+    if (a == b) {
+        return true;
+    }
+    // nullptr 视为 sRGB
+    const EgColorSpace* srgb = MakeSRGB().get();
+    a = a ? a : srgb;
+    b = b ? b : srgb;
+    return a->fTransferFn == b->fTransferFn && a->fToXYZD50 == b->fToXYZD50;
+}
@@ -0,0 +1,79 @@
+#include "src/core/EgColorSpaceXformSteps.h"
+
+EgColorSpaceXformSteps::EgColorSpaceXformSteps(const EgColorSpace* src, EgAlphaType srcAT,
+                                               const EgColorSpace* dst, EgAlphaType dstAT) {
+    const EgColorSpace* srgb = EgColorSpace::MakeSRGB().get();
+    src = src ? src : srgb;
+    dst = dst ? dst : srgb;
+
+    // 不透明的颜色按非预乘处理，预乘与否对它没有区别
+    if (srcAT == gOpaque_EgAlphaType) {
+        srcAT = gUnpremul_EgAlphaType;
+    }
+    if (dstAT == gOpaque_EgAlphaType) {
+        dstAT = gUnpremul_EgAlphaType;
+    }
+
+    fFlags.unpremul        = srcAT == gPremul_EgAlphaType;
+    fFlags.linearize       = !src->gammaIsLinear();
+    fFlags.gamut_transform = src->toXYZD50() != dst->toXYZD50();
+    fFlags.encode          = !dst->gammaIsLinear();
+    fFlags.premul          = dstAT == gPremul_EgAlphaType;
+
+    if (fFlags.gamut_transform) {
+        EgColorMatrix3x3 m = EgColorMatrix3x3::Concat(dst->fromXYZD50(), src->toXYZD50());
+        for (int i = 0; i < 9; ++i) {
+            fSrcToDstMatrix.m[i] = m.vals[i / 3][i % 3];
+        }
+    }
+    fSrcTF    = src->transferFn();
+    fDstTFInv = dst->invTransferFn();
+
+    // 传递函数相同且无需色域转换时，linearize 与 encode 互相抵消
+    if (!fFlags.gamut_transform && src->transferFn() == dst->transferFn()) {
+        fFlags.linearize = false;
+        fFlags.encode    = false;
+    }
+    // 中间没有任何需要非预乘颜色的步骤时，unpremul 与 premul 也互相抵消
+    if (!fFlags.linearize && !fFlags.gamut_transform && !fFlags.encode &&
+        fFlags.unpremul && fFlags.premul) {
+        fFlags.unpremul = false;
+        fFlags.premul   = false;
+    }
+}
+
+void EgColorSpaceXformSteps::apply(float rgba[4]) const {
+    EgRasterPipeline_MemoryCtx memory = {rgba, 1};
+    EgSTArenaAlloc<256> alloc;
+    EgRasterPipeline pipeline(&alloc);
+    pipeline.append(EgRasterPipelineOp::load_f32, &memory);
+    this->apply(&pipeline);
+    pipeline.append(EgRasterPipelineOp::store_f32, &memory);
+    pipeline.run(0, 0, 1, 1);
+}
+
+void EgColorSpaceXformSteps::apply(EgRasterPipeline* pipeline) const {
+    if (fFlags.unpremul) {
+        pipeline->append(EgRasterPipelineOp::unpremul);
+    }
+    if (fFlags.linearize) {
+        switch (fSrcTF.fType) {
+            case EgTransferFunction::gParametric: pipeline->append(EgRasterPipelineOp::parametric, &fSrcTF); break;
+            case EgTransferFunction::gPQ:         pipeline->append(EgRasterPipelineOp::pq);                 break;
+            case EgTransferFunction::gHLG:        pipeline->append(EgRasterPipelineOp::hlg);                break;
+        }
+    }
+    if (fFlags.gamut_transform) {
+        pipeline->append(EgRasterPipelineOp::gamut_3x3, &fSrcToDstMatrix);
+    }
+    if (fFlags.encode) {
+        switch (fDstTFInv.fType) {
+            case EgTransferFunction::gParametric: pipeline->append(EgRasterPipelineOp::parametric, &fDstTFInv); break;
+            case EgTransferFunction::gPQ:         pipeline->append(EgRasterPipelineOp::inv_pq);                 break;
+            case EgTransferFunction::gHLG:        pipeline->append(EgRasterPipelineOp::inv_hlg);                break;
+        }
+    }
+    if (fFlags.premul) {
+        pipeline->append(EgRasterPipelineOp::premul);
+    }
+}
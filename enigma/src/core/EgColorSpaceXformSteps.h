@@ -0,0 +1,38 @@
+#pragma once
+
+#include "include/core/EgAlphaType.h"
+#include "include/core/EgColorSpace.h"
+
+#include "src/core/EgRasterPipeline.h"
+
+/**
+ * @brief 颜色空间转换拆成的步骤：unpremul -> linearize -> gamut -> encode -> premul
+ *
+ * 构造时只计算需要哪些步骤，源与目标相同的部分会被省略；
+ * 转换本身作为几个阶段追加到光栅流水线中，与其他阶段在同一趟中完成。
+ * nullptr 颜色空间视为 sRGB。
+ */
+struct EgColorSpaceXformSteps {
+    struct Flags {
+        bool unpremul           = false;
+        bool linearize          = false;
+        bool gamut_transform    = false;
+        bool encode             = false;
+        bool premul             = false;
+    };
+
+    EgColorSpaceXformSteps(const EgColorSpace* src, EgAlphaType srcAT,
+                           const EgColorSpace* dst, EgAlphaType dstAT);
+
+    /**
+     * @brief 原地转换单个颜色 (r, g, b, a)，例如画笔颜色
+     */
+    void apply(float rgba[4]) const;
+
+    void apply(EgRasterPipeline* pipeline) const;
+
+    Flags                       fFlags;
+    EgTransferFunction          fSrcTF;         // 编码值 -> 线性
+    EgTransferFunction          fDstTFInv;      // 线性 -> 编码值
+    EgRasterPipeline_GamutCtx   fSrcToDstMatrix;
+};
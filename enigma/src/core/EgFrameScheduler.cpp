@@ -0,0 +1,148 @@
+#include "include/core/EgFrameScheduler.h"
+
+#include "include/core/EgMemory.h"
+#include "include/private/base/EgAssert.h"
+#include "include/utils/EgTrace.h"
+
+#include "src/base/EgRingQueue.h"
+
+#include <atomic>
+#include <chrono>
+#include <pthread.h>
+#include <semaphore>
+#include <string>
+#include <thread>
+
+struct EgFrameScheduler::Impl {
+    explicit Impl(std::vector<std::unique_ptr<EgFrameRecording>> recordings)
+        : fRecordings(std::move(recordings))
+        // 提交队列多留一格给退出标记
+        , fSubmitted(fRecordings.size() + 1)
+        , fFree(fRecordings.size())
+        , fSubmittedCount(0)
+        , fFreeCount((std::ptrdiff_t)fRecordings.size()) {
+        for (const auto& recording : fRecordings) {
+            EgAssert(recording != nullptr);
+            fFree.tryPush(recording.get());
+        }
+    }
+
+    void threadMain(const std::string& threadName) {
+        // pthread 线程名最长 15 个字符
+        pthread_setname_np(pthread_self(), threadName.substr(0, 15).c_str());
+        for (;;) {
+            fSubmittedCount.acquire();
+            EgFrameRecording* frame = nullptr;
+            bool popped = fSubmitted.tryPop(&frame);
+            EgAssert(popped);
+            (void)popped;
+            if (frame == nullptr) {
+                return;
+            }
+            {
+                EG_TRACE_EVENT("frame", "EgFrameScheduler::render");
+                frame->render();
+            }
+            fFree.tryPush(frame);
+            fFreeCount.release();
+            fRendered.fetch_add(1, std::memory_order_release);
+            fRendered.notify_all();
+        }
+    }
+
+    EgFrameRecording* takeFree() {
+        EgFrameRecording* frame = nullptr;
+        bool popped = fFree.tryPop(&frame);
+        EgAssert(popped);
+        (void)popped;
+        frame->reset();
+        return frame;
+    }
+
+    std::vector<std::unique_ptr<EgFrameRecording>>  fRecordings;
+
+    // UI 线程 -> 渲染线程：待渲染的帧；渲染线程 -> UI 线程：可复用的帧
+    EgSPSCQueue<EgFrameRecording*>                  fSubmitted;
+    EgSPSCQueue<EgFrameRecording*>                  fFree;
+
+    // 队列本身不阻塞，信号量只用于没有数据时让线程睡眠，计数与队列中的元素个数一致
+    std::counting_semaphore<kMaxDepth + 1>          fSubmittedCount;
+    std::counting_semaphore<kMaxDepth>              fFreeCount;
+
+    uint64_t                                        fSubmittedTotal = 0;    // 只由 UI 线程访问
+    std::atomic<uint64_t>                           fRendered {0};
+    std::atomic<uint64_t>                           fStallNs {0};
+
+    std::thread                                     fThread;
+};
+
+EgFrameScheduler::EgFrameScheduler(std::vector<std::unique_ptr<EgFrameRecording>> recordings,
+                                   const char* threadName) {
+    EgAssertRelease(recordings.size() >= kMinDepth && recordings.size() <= kMaxDepth);
+    fImpl = std::make_unique<Impl>(std::move(recordings));
+    std::string name = threadName ? threadName : "EgRender";
+    fImpl->fThread = std::thread([impl = fImpl.get(), name] { impl->threadMain(name); });
+}
+
+EgFrameScheduler::~EgFrameScheduler() {
+    // 退出标记排在所有已提交的帧之后，渲染线程处理完它们才会退出
+    bool pushed = fImpl->fSubmitted.tryPush(nullptr);
+    EgAssert(pushed);
+    (void)pushed;
+    fImpl->fSubmittedCount.release();
+    fImpl->fThread.join();
+}
+
+int EgFrameScheduler::depth() const {
+    return (int)fImpl->fRecordings.size();
+}
+
+EgFrameRecording* EgFrameScheduler::beginFrame() {
+    // 帧与帧之间 UI 线程不持有其他锁，是执行延后的内存清理的安全点
+    EgMemory::PurgeIfOverBudget();
+    if (!fImpl->fFreeCount.try_acquire()) {
+        // 所有录制对象都在途，等待渲染线程归还
+        EG_TRACE_EVENT("frame", "EgFrameScheduler::stall");
+        auto start = std::chrono::steady_clock::now();
+        fImpl->fFreeCount.acquire();
+        auto stall = std::chrono::steady_clock::now() - start;
+        fImpl->fStallNs.fetch_add(
+                (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(stall).count(),
+                std::memory_order_relaxed);
+    }
+    return fImpl->takeFree();
+}
+
+EgFrameRecording* EgFrameScheduler::tryBeginFrame() {
+    EgMemory::PurgeIfOverBudget();
+    if (!fImpl->fFreeCount.try_acquire()) {
+        return nullptr;
+    }
+    return fImpl->takeFree();
+}
+
+void EgFrameScheduler::submitFrame(EgFrameRecording* frame) {
+    EgAssert(frame != nullptr);
+    // 在途的帧不超过 depth 个，提交队列不会满
+    bool pushed = fImpl->fSubmitted.tryPush(frame);
+    EgAssert(pushed);
+    (void)pushed;
+    fImpl->fSubmittedTotal++;
+    fImpl->fSubmittedCount.release();
+}
+
+void EgFrameScheduler::flush() {
+    const uint64_t target = fImpl->fSubmittedTotal;
+    for (uint64_t rendered = fImpl->fRendered.load(std::memory_order_acquire); rendered < target;
+         rendered = fImpl->fRendered.load(std::memory_order_acquire)) {
+        fImpl->fRendered.wait(rendered, std::memory_order_acquire);
+    }
+}
+
+EgFrameScheduler::Stats EgFrameScheduler::stats() const {
+    return {
+        fImpl->fSubmittedTotal,
+        fImpl->fRendered.load(std::memory_order_acquire),
+        fImpl->fStallNs.load(std::memory_order_relaxed),
+    };
+}
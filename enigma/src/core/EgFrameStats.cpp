@@ -0,0 +1,53 @@
+#include "include/core/EgFrameStats.h"
+
+#include "src/core/EgFrameStatsPriv.h"
+
+EgFrameStatsCounters gEgFrameStatsCounters;
+
+namespace {
+
+template <bool kReset>
+static uint64_t read_counter(std::atomic<uint64_t>& counter) {
+    return kReset ? counter.exchange(0, std::memory_order_relaxed)
+                  : counter.load(std::memory_order_relaxed);
+}
+
+template <bool kReset>
+static EgFrameStats read_counters() {
+    EgFrameStatsCounters& counters = gEgFrameStatsCounters;
+    EgFrameStats stats;
+    for (int i = 0; i <= gLastEnum_EgDrawType; ++i) {
+        stats.fDraws[i] = read_counter<kReset>(counters.fDraws[i]);
+    }
+    for (int i = 0; i < gEgBlendModeCount; ++i) {
+        stats.fPixelsBlended[i] = read_counter<kReset>(counters.fPixelsBlended[i]);
+    }
+    stats.fPipelinesBuilt  = read_counter<kReset>(counters.fPipelinesBuilt);
+    stats.fCacheHits       = read_counter<kReset>(counters.fCacheHits);
+    stats.fCacheMisses     = read_counter<kReset>(counters.fCacheMisses);
+    stats.fBytesAllocated  = read_counter<kReset>(counters.fBytesAllocated);
+    return stats;
+}
+
+}  // namespace
+
+uint64_t EgFrameStats::totalDraws() const {
+    uint64_t total = 0;
+    for (uint64_t draws : fDraws) {
+        total += draws;
+    }
+    return total;
+}
+
+double EgFrameStats::cacheHitRate() const {
+    const uint64_t lookups = fCacheHits + fCacheMisses;
+    return lookups ? (double)fCacheHits / (double)lookups : 0.0;
+}
+
+EgFrameStats EgFrameStats::Peek() {
+    return read_counters<false>();
+}
+
+EgFrameStats EgFrameStats::EndFrame() {
+    return read_counters<true>();
+}
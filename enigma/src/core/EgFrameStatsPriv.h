@@ -0,0 +1,31 @@
+#pragma once
+
+#include "include/core/EgFrameStats.h"
+
+#include <atomic>
+
+/**
+ * @brief EgFrameStats 的全局计数器，字段与 EgFrameStats 一一对应
+ */
+struct EgFrameStatsCounters {
+    std::atomic<uint64_t>   fDraws[gLastEnum_EgDrawType + 1];
+    std::atomic<uint64_t>   fPixelsBlended[gEgBlendModeCount];
+    std::atomic<uint64_t>   fPipelinesBuilt;
+    std::atomic<uint64_t>   fCacheHits;
+    std::atomic<uint64_t>   fCacheMisses;
+    std::atomic<uint64_t>   fBytesAllocated;
+};
+
+extern EgFrameStatsCounters gEgFrameStatsCounters;
+
+static inline void EgFrameStats_Add(std::atomic<uint64_t> EgFrameStatsCounters::* counter, uint64_t value = 1) {
+    (gEgFrameStatsCounters.*counter).fetch_add(value, std::memory_order_relaxed);
+}
+
+static inline void EgFrameStats_AddDraw(EgDrawType type) {
+    gEgFrameStatsCounters.fDraws[type].fetch_add(1, std::memory_order_relaxed);
+}
+
+static inline void EgFrameStats_AddPixelsBlended(EgBlendMode mode, uint64_t pixels) {
+    gEgFrameStatsCounters.fPixelsBlended[(int)mode].fetch_add(pixels, std::memory_order_relaxed);
+}
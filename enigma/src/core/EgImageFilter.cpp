@@ -0,0 +1,157 @@
+#include "include/core/EgImageFilter.h"
+#include "include/utils/EgTrace.h"
+
+#include "src/core/EgFrameStatsPriv.h"
+#include "src/core/EgImageFilterBase.h"
+
+#include <algorithm>
+#include <cstring>
+
+EgIRect EgImageFilter::filterBounds(const EgIRect& src, MapDirection direction) const {
+    const EgImageFilterBase* self = as_IFB(this);
+    if (direction == gForward_MapDirection) {
+        EgIRect joined = this->countInputs() == 0 ? src : EgIRect::MakeEmpty();
+        for (int i = 0; i < this->countInputs(); ++i) {
+            const EgImageFilter* input = this->getInput(i);
+            joined.join(input ? input->filterBounds(src, direction) : src);
+        }
+        return self->onFilterNodeBounds(joined, direction);
+    }
+
+    EgIRect required = self->onFilterNodeBounds(src, direction);
+    if (this->countInputs() == 0) {
+        return required;
+    }
+    EgIRect joined = EgIRect::MakeEmpty();
+    for (int i = 0; i < this->countInputs(); ++i) {
+        const EgImageFilter* input = this->getInput(i);
+        joined.join(input ? input->filterBounds(required, direction) : required);
+    }
+    return joined;
+}
+
+void EgLoadPremulRow(const EgSpecialImage* image, int left, int y, int count, egvx::float4* dst) {
+    std::fill(dst, dst + count, egvx::float4(0.0f));
+    if (image == nullptr || y < image->bounds().fTop || y >= image->bounds().fBottom) {
+        return;
+    }
+    const int begin = std::max(left, image->bounds().fLeft);
+    const int end   = std::min(left + count, image->bounds().fRight);
+    const uint8_t* src = begin < end ? image->getAddr(begin, y) : nullptr;
+    for (int x = begin; x < end; ++x, src += 4) {
+        dst[x - left] = EgLoadPremul(src);
+    }
+}
+
+////////////////////////////////////////////////////////
+
+EgIRect EgImageFilterCache::contentBounds(const EgImageFilterBase* filter) {
+    if (filter == nullptr) {
+        return fSourceBounds;
+    }
+    // 按值返回：递归计算输入时的插入可能让表扩容，引用会失效
+    if (const EgIRect* bounds = fContentBounds.find(filter)) {
+        return *bounds;
+    }
+
+    EgIRect joined = filter->countInputs() == 0 ? fSourceBounds : EgIRect::MakeEmpty();
+    for (int i = 0; i < filter->countInputs(); ++i) {
+        joined.join(this->contentBounds(as_IFB(filter->getInput(i))));
+    }
+    EgIRect bounds = filter->onFilterNodeBounds(joined, EgImageFilter::gForward_MapDirection);
+    fContentBounds.set(filter, bounds);
+    return bounds;
+}
+
+bool EgImageFilterCache::find(const EgImageFilterBase* filter, const EgIRect& desired,
+                              EgSp<EgSpecialImage>* result) const {
+    for (const Entry& entry : fTileEntries) {
+        if (entry.fFilter == filter && entry.fDesired.contains(desired)) {
+            *result = entry.fImage;
+            EgFrameStats_Add(&EgFrameStatsCounters::fCacheHits);
+            return true;
+        }
+    }
+    EgFrameStats_Add(&EgFrameStatsCounters::fCacheMisses);
+    return false;
+}
+
+void EgImageFilterCache::add(const EgImageFilterBase* filter, const EgIRect& desired,
+                             EgSp<EgSpecialImage> result) {
+    fTileEntries.push_back({filter, desired, std::move(result)});
+}
+
+////////////////////////////////////////////////////////
+
+EgSp<EgSpecialImage> EgImageFilterBase::filterImage(const EgImageFilterContext& ctx) const {
+    EgImageFilterCache* cache = ctx.cache();
+    EgIRect desired;
+    if (!desired.intersect(ctx.desiredOutput(), cache->contentBounds(this))) {
+        return nullptr;
+    }
+
+    EgSp<EgSpecialImage> result;
+    if (cache->find(this, desired, &result)) {
+        return result;
+    }
+    EG_TRACE_EVENT1("imagefilter", "EgImageFilter::filterImage", "inputs", this->countInputs());
+    result = this->onFilterImage(ctx.withNewDesiredOutput(desired));
+    cache->add(this, desired, result);
+    return result;
+}
+
+EgSp<EgSpecialImage> EgImageFilterBase::filterInput(int index, const EgImageFilterContext& ctx) const {
+    EgIRect required = this->onFilterNodeBounds(ctx.desiredOutput(), gReverse_MapDirection);
+    const EgImageFilter* input = this->getInput(index);
+    if (input != nullptr) {
+        return as_IFB(input)->filterImage(ctx.withNewDesiredOutput(required));
+    }
+    if (ctx.source() == nullptr) {
+        return nullptr;
+    }
+    return ctx.source()->makeSubset(required);
+}
+
+bool EgImageFilterBase::FilterLayer(const EgImageFilter* filter, const EgMask& src,
+                                    const EgIRect& clip, EgMask* dst) {
+    EgAssert(filter != nullptr && dst != nullptr);
+    if (src.fFormat != EgMask::gARGB32_Format) {
+        return false;
+    }
+    EG_TRACE_EVENT("imagefilter", "EgImageFilter::FilterLayer");
+    EgFrameStats_AddDraw(gImageFilterLayer_EgDrawType);
+
+    EgImageFilterCache cache(src.fBounds);
+    EgIRect outputBounds;
+    if (!outputBounds.intersect(cache.contentBounds(as_IFB(filter)), clip)) {
+        return false;
+    }
+
+    dst->fFormat = EgMask::gARGB32_Format;
+    dst->fBounds = outputBounds;
+    if (!dst->allocImage()) {
+        return false;
+    }
+
+    EgSp<EgSpecialImage> source = EgSpecialImage::MakeView(src);
+    for (int top = outputBounds.fTop; top < outputBounds.fBottom; top += kTileSize) {
+        for (int left = outputBounds.fLeft; left < outputBounds.fRight; left += kTileSize) {
+            EgIRect tile = EgIRect::MakeLTRB(left, top,
+                                             std::min(left + kTileSize, outputBounds.fRight),
+                                             std::min(top + kTileSize, outputBounds.fBottom));
+            EG_TRACE_EVENT("imagefilter", "FilterTile");
+            cache.resetTile();
+
+            EgImageFilterContext ctx(tile, source.get(), &cache);
+            EgSp<EgSpecialImage> result = as_IFB(filter)->filterImage(ctx);
+            EgIRect copy;
+            if (!result || !copy.intersect(result->bounds(), tile)) {
+                continue;
+            }
+            for (int y = copy.fTop; y < copy.fBottom; ++y) {
+                memcpy(dst->getAddr(copy.fLeft, y), result->getAddr(copy.fLeft, y), (size_t)copy.width() * 4);
+            }
+        }
+    }
+    return true;
+}
@@ -0,0 +1,173 @@
+#pragma once
+
+#include "include/core/EgColorFilter.h"
+#include "include/core/EgImageFilter.h"
+
+#include "src/base/EgVx.h"
+#include "src/core/EgMask.h"
+#include "src/core/EgSpecialImage.h"
+#include "src/core/EgTHash.h"
+
+#include <vector>
+
+class EgImageFilterBase;
+
+/**
+ * @brief 一次滤镜求值的共享状态
+ *
+ * - 每个节点的前向内容范围只计算一次，整次求值期间有效；
+ * - 节点的输出按 tile 缓存，同一个节点在 DAG 中被多次引用时只求值一次，
+ *   换到下一个 tile 前调用 resetTile 清空，因此缓存占用的内存与 tile 大小相当。
+ */
+class EgImageFilterCache {
+public:
+    explicit EgImageFilterCache(const EgIRect& sourceBounds) : fSourceBounds(sourceBounds) {}
+
+    /**
+     * @brief 节点（nullptr 表示源图像）输出可能非透明的范围
+     */
+    EgIRect contentBounds(const EgImageFilterBase* filter);
+
+    /**
+     * @brief 查找 filter 在当前 tile 中已计算出的、覆盖 desired 的结果
+     */
+    bool find(const EgImageFilterBase* filter, const EgIRect& desired,
+              EgSp<EgSpecialImage>* result) const;
+
+    void add(const EgImageFilterBase* filter, const EgIRect& desired,
+             EgSp<EgSpecialImage> result);
+
+    void resetTile() { fTileEntries.clear(); }
+
+private:
+    struct Entry {
+        const EgImageFilterBase*            fFilter;
+        EgIRect                             fDesired;
+        EgSp<EgSpecialImage>     fImage;
+    };
+
+    EgIRect                                                     fSourceBounds;
+    EgTHashMap<const EgImageFilterBase*, EgIRect>               fContentBounds;
+    std::vector<Entry>                                          fTileEntries;
+};
+
+/**
+ * @brief 节点求值的上下文
+ */
+class EgImageFilterContext {
+public:
+    EgImageFilterContext(const EgIRect& desiredOutput, const EgSpecialImage* source, EgImageFilterCache* cache)
+        : fDesiredOutput(desiredOutput)
+        , fSource(source)
+        , fCache(cache) {}
+
+    /**
+     * @brief 需要计算的输出范围，结果在此范围之外的像素会被忽略
+     */
+    const EgIRect& desiredOutput() const { return fDesiredOutput; }
+
+    const EgSpecialImage* source() const { return fSource; }
+
+    EgImageFilterCache* cache() const { return fCache; }
+
+    EgImageFilterContext withNewDesiredOutput(const EgIRect& desiredOutput) const {
+        return EgImageFilterContext(desiredOutput, fSource, fCache);
+    }
+
+private:
+    EgIRect                 fDesiredOutput;
+    const EgSpecialImage*   fSource;
+    EgImageFilterCache*     fCache;
+};
+
+class EgImageFilterBase : public EgImageFilter {
+public:
+    /**
+     * @brief 计算 ctx.desiredOutput() 范围内的输出
+     *
+     * 期望范围先与节点的内容范围求交，交集为空时直接返回 nullptr（全透明），
+     * 不会再向输入请求像素。
+     * @return 结果图像，范围可能大于或小于期望范围，缺失的部分视为透明；nullptr 表示全透明
+     */
+    EgSp<EgSpecialImage> filterImage(const EgImageFilterContext& ctx) const;
+
+    /**
+     * @brief 只对本节点做范围映射，不递归到输入
+     *
+     * - gForward_MapDirection : src 为所有输入内容范围的并集
+     * - gReverse_MapDirection : src 为期望的输出范围，返回每个输入所需的范围
+     */
+    virtual EgIRect onFilterNodeBounds(const EgIRect& src, MapDirection direction) const {
+        return src;
+    }
+
+    /**
+     * @brief 若本节点只是对输入应用颜色滤镜，返回 true 并通过 filter 返回该颜色滤镜
+     */
+    virtual bool isColorFilterNode(EgSp<EgColorFilter>* filter) const {
+        return false;
+    }
+
+    /**
+     * @brief 对图层 src 应用 filter，按 tile 求值，结果写入 dst
+     *
+     * 输出范围为滤镜的前向内容范围与 clip 的交集；每个 tile 只向输入请求影响它的像素。
+     * @param src 源图层，格式必须为 gARGB32_Format
+     * @param dst 输出，图像内存由本函数分配，调用者负责通过 EgMask::FreeImage 释放
+     * @return 输出为空或分配失败时返回 false
+     */
+    static bool FilterLayer(const EgImageFilter* filter, const EgMask& src, const EgIRect& clip, EgMask* dst);
+
+    /**
+     * @brief tile 的边长（像素）
+     *
+     * 128x128 的 ARGB32 tile 为 64KB，加上各级输入的外扩部分和中间结果，
+     * 单个 tile 的工作集仍能留在常见的 256KB ~ 1MB L2 中。
+     */
+    static constexpr int kTileSize = 128;
+
+    /**
+     * @brief 表示"不受输入约束"的内容范围，例如会改变透明黑的颜色滤镜
+     */
+    static constexpr EgIRect Unbounded() {
+        return EgIRect::MakeLTRB(-(1 << 29), -(1 << 29), 1 << 29, 1 << 29);
+    }
+
+protected:
+    explicit EgImageFilterBase(std::vector<EgSp<EgImageFilter>> inputs)
+        : EgImageFilter(std::move(inputs)) {}
+
+    /**
+     * @brief 计算本节点在 ctx.desiredOutput() 范围内的输出，期望范围已与内容范围求交
+     */
+    virtual EgSp<EgSpecialImage> onFilterImage(const EgImageFilterContext& ctx) const = 0;
+
+    /**
+     * @brief 求值第 index 个输入，请求范围为 desiredOutput 的反向映射
+     */
+    EgSp<EgSpecialImage> filterInput(int index, const EgImageFilterContext& ctx) const;
+};
+
+static inline EgImageFilterBase* as_IFB(EgImageFilter* filter) {
+    return static_cast<EgImageFilterBase*>(filter);
+}
+
+static inline const EgImageFilterBase* as_IFB(const EgImageFilter* filter) {
+    return static_cast<const EgImageFilterBase*>(filter);
+}
+
+/**
+ * @brief 预乘 ARGB32 像素与 egvx::float4 之间的转换
+ */
+static inline egvx::float4 EgLoadPremul(const uint8_t* pixel) {
+    return egvx::cast<float>(egvx::Vec<4, uint8_t>::Load(pixel)) * (1.0f / 255.0f);
+}
+
+static inline void EgStorePremul(const egvx::float4& color, uint8_t* pixel) {
+    egvx::cast<uint8_t>(egvx::cast<int32_t>(color * 255.0f + 0.5f)).store(pixel);
+}
+
+/**
+ * @brief 读取 image 第 y 行 [left, left + count) 的像素，image 为 nullptr 或不覆盖的部分为透明
+ */
+void EgLoadPremulRow(const EgSpecialImage* image, int left, int y, int count, egvx::float4* dst);
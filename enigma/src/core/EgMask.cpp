@@ -0,0 +1,41 @@
+#include "src/core/EgMask.h"
+
+#include "include/core/EgMemory.h"
+
+#include "include/private/base/EgSafeMath.h"
+#include "src/core/EgFrameStatsPriv.h"
+
+#include <cstdlib>
+#include <cstring>
+
+size_t EgMask::computeImageSize() const {
+    if (fBounds.isEmpty()) {
+        return 0;
+    }
+    EgSafeMath safe;
+    size_t rowBytes = safe.mul(fBounds.width(), this->bytesPerPixel());
+    size_t size = safe.mul(rowBytes, fBounds.height());
+    return safe.ok() ? size : 0;
+}
+
+bool EgMask::allocImage() {
+    size_t size = this->computeImageSize();
+    if (size == 0) {
+        return false;
+    }
+    fRowBytes = (uint32_t)(fBounds.width() * this->bytesPerPixel());
+    fImage = AllocImage(size);
+    if (fImage == nullptr) {
+        return false;
+    }
+    EgFrameStats_Add(&EgFrameStatsCounters::fBytesAllocated, size);
+    return true;
+}
+
+uint8_t* EgMask::AllocImage(size_t size) {
+    return static_cast<uint8_t*>(EgMemory::Calloc(gPixels_EgMemorySubsystem, size));
+}
+
+void EgMask::FreeImage(void* image) {
+    EgMemory::Free(gPixels_EgMemorySubsystem, image);
+}
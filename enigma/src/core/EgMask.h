@@ -0,0 +1,83 @@
+#pragma once
+
+#include "include/private/base/EgAPI.h"
+#include "include/private/base/EgAssert.h"
+#include "include/core/EgRect.h"
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief 遮罩/离屏像素块
+ *
+ * fImage 指向像素数据，fBounds 为其在设备空间中的位置，fRowBytes 为每行字节数。
+ * - gA8_Format     : 每像素 1 字节的覆盖率（alpha）
+ * - gARGB32_Format : 每像素 4 字节的预乘颜色，字节序与 EgColor4f::toBytes_RGBA 一致
+ */
+struct EG_API EgMask {
+    enum Format : uint8_t {
+        gA8_Format,
+        gARGB32_Format,
+    };
+
+    uint8_t*    fImage      = nullptr;
+    EgIRect     fBounds     = EgIRect::MakeEmpty();
+    uint32_t    fRowBytes   = 0;
+    Format      fFormat     = gA8_Format;
+
+    /**
+     * @brief 每像素字节数
+     */
+    static constexpr int BytesPerPixel(Format format) {
+        return format == gARGB32_Format ? 4 : 1;
+    }
+
+    int bytesPerPixel() const { return BytesPerPixel(fFormat); }
+
+    bool isEmpty() const { return fBounds.isEmpty(); }
+
+    /**
+     * @brief 按 fBounds 和 fFormat 计算图像所需字节数，溢出时返回 0
+     */
+    size_t computeImageSize() const;
+
+    /**
+     * @brief 按 fBounds 和 fFormat 设置 fRowBytes 并分配（清零的）图像内存
+     * @return 分配失败或尺寸溢出时返回 false
+     */
+    bool allocImage();
+
+    /**
+     * @brief 获取 (x, y) 处像素的地址，x/y 为设备空间坐标
+     */
+    uint8_t* getAddr(int x, int y) const {
+        EgAssert(fImage != nullptr);
+        EgAssert(fBounds.contains(x, y));
+        return fImage + (size_t)(y - fBounds.fTop) * fRowBytes
+                      + (size_t)(x - fBounds.fLeft) * this->bytesPerPixel();
+    }
+
+    static uint8_t* AllocImage(size_t size);
+    static void FreeImage(void* image);
+};
+
+/**
+ * @brief 持有 EgMask 图像内存的 RAII 辅助类
+ */
+class EgAutoMaskFreeImage {
+public:
+    explicit EgAutoMaskFreeImage(uint8_t* image) : mImage(image) {}
+    ~EgAutoMaskFreeImage() { EgMask::FreeImage(mImage); }
+
+    EgAutoMaskFreeImage(const EgAutoMaskFreeImage&) = delete;
+    EgAutoMaskFreeImage& operator=(const EgAutoMaskFreeImage&) = delete;
+
+    uint8_t* release() {
+        uint8_t* image = mImage;
+        mImage = nullptr;
+        return image;
+    }
+
+private:
+    uint8_t* mImage;
+};
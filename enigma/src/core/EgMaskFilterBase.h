@@ -0,0 +1,36 @@
+#pragma once
+
+#include "include/core/EgMaskFilter.h"
+
+#include "src/core/EgMask.h"
+
+class EgMaskFilterBase : public EgMaskFilter {
+public:
+    /**
+     * @brief 对 A8 遮罩 src 应用滤镜，结果写入 dst
+     *
+     * dst 的图像内存由实现分配，调用者通过 EgMask::FreeImage 释放。
+     * @return 滤镜无法处理时返回 false，此时 dst 未被修改
+     */
+    virtual bool filterMask(EgMask* dst, const EgMask& src) const = 0;
+
+    /**
+     * @brief 直接由圆角矩形几何生成滤镜后的遮罩，跳过光栅化 + filterMask
+     *
+     * 卡片、对话框的阴影都是这种情况，解析计算比对遮罩做模糊便宜得多。
+     * @param rect 设备空间中的矩形
+     * @param cornerRadius 圆角半径，0 表示普通矩形
+     * @return 不支持时返回 false，调用者应退回到 filterMask
+     */
+    virtual bool filterRRectMask(EgMask* dst, const EgRect& rect, EgScalar cornerRadius) const {
+        return false;
+    }
+};
+
+static inline EgMaskFilterBase* as_MFB(EgMaskFilter* mf) {
+    return static_cast<EgMaskFilterBase*>(mf);
+}
+
+static inline const EgMaskFilterBase* as_MFB(const EgMaskFilter* mf) {
+    return static_cast<const EgMaskFilterBase*>(mf);
+}
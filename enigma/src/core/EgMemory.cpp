@@ -0,0 +1,203 @@
+#include "include/core/EgMemory.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <malloc.h>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct SubsystemCounters {
+    alignas(64) std::atomic<size_t>     fCurrent {0};
+    std::atomic<size_t>                 fPeak {0};
+};
+
+struct PurgeEntry {
+    int                         fId;
+    EgMemory::PurgeCallback     fCallback;
+};
+
+struct MemoryState {
+    SubsystemCounters           fSubsystems[gLastEnum_EgMemorySubsystem + 1];
+    alignas(64) std::atomic<size_t> fTotal {0};
+    std::atomic<size_t>         fBudget {0};
+    std::atomic<bool>           fPurgePending {false};
+
+    std::recursive_mutex        fPurgeMutex;
+    std::vector<PurgeEntry>     fPurgeCallbacks;
+    int                         fNextId = 1;
+};
+
+static MemoryState& state() {
+    // 有意泄漏：静态析构之后仍可能有内存被释放
+    static MemoryState* gState = new MemoryState();
+    return *gState;
+}
+
+/**
+ * @brief 本线程是否正在执行清理回调，防止回调内再次进入 PurgeIfOverBudget
+ */
+thread_local bool gInPurge = false;
+
+static void update_peak(std::atomic<size_t>& peak, size_t value) {
+    size_t old = peak.load(std::memory_order_relaxed);
+    while (old < value && !peak.compare_exchange_weak(old, value, std::memory_order_relaxed)) {
+    }
+}
+
+static void on_allocated(EgMemorySubsystem subsystem, void* ptr) {
+    const size_t size = malloc_usable_size(ptr);
+    MemoryState& s = state();
+    SubsystemCounters& counters = s.fSubsystems[subsystem];
+    update_peak(counters.fPeak, counters.fCurrent.fetch_add(size, std::memory_order_relaxed) + size);
+
+    const size_t total = s.fTotal.fetch_add(size, std::memory_order_relaxed) + size;
+    const size_t budget = s.fBudget.load(std::memory_order_relaxed);
+    // 分配路径上只记下需要清理，回调在 PurgeIfOverBudget 的安全点执行：
+    // 这里可能持有调用者的锁，同步执行回调会把所有分配串行化，还可能与回调内的加锁死锁。
+    // 先读再写，已经标记过时不再写这条共享的缓存行
+    if (budget != 0 && total > budget && !s.fPurgePending.load(std::memory_order_relaxed)) {
+        s.fPurgePending.store(true, std::memory_order_relaxed);
+    }
+}
+
+static void on_freed(EgMemorySubsystem subsystem, void* ptr) {
+    const size_t size = malloc_usable_size(ptr);
+    MemoryState& s = state();
+    s.fSubsystems[subsystem].fCurrent.fetch_sub(size, std::memory_order_relaxed);
+    s.fTotal.fetch_sub(size, std::memory_order_relaxed);
+}
+
+}  // namespace
+
+void* EgMemory::Malloc(EgMemorySubsystem subsystem, size_t size) {
+    void* ptr = malloc(size);
+    if (ptr) {
+        on_allocated(subsystem, ptr);
+    }
+    return ptr;
+}
+
+void* EgMemory::Calloc(EgMemorySubsystem subsystem, size_t size) {
+    void* ptr = calloc(size, 1);
+    if (ptr) {
+        on_allocated(subsystem, ptr);
+    }
+    return ptr;
+}
+
+void* EgMemory::Realloc(EgMemorySubsystem subsystem, void* ptr, size_t size) {
+    // realloc 之后旧指针不可再访问，先按释放记账；失败时旧块仍然有效，再记回去
+    if (ptr) {
+        on_freed(subsystem, ptr);
+    }
+    void* result = realloc(ptr, size);
+    if (result) {
+        on_allocated(subsystem, result);
+    } else if (ptr && size != 0) {
+        on_allocated(subsystem, ptr);
+    }
+    return result;
+}
+
+void EgMemory::Free(EgMemorySubsystem subsystem, void* ptr) {
+    if (ptr) {
+        on_freed(subsystem, ptr);
+        free(ptr);
+    }
+}
+
+EgMemory::Usage EgMemory::GetUsage(EgMemorySubsystem subsystem) {
+    const SubsystemCounters& counters = state().fSubsystems[subsystem];
+    return {counters.fCurrent.load(std::memory_order_relaxed), counters.fPeak.load(std::memory_order_relaxed)};
+}
+
+size_t EgMemory::TotalBytes() {
+    return state().fTotal.load(std::memory_order_relaxed);
+}
+
+void EgMemory::ResetPeaks() {
+    for (SubsystemCounters& counters : state().fSubsystems) {
+        counters.fPeak.store(counters.fCurrent.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+}
+
+void EgMemory::SetBudget(size_t bytes) {
+    state().fBudget.store(bytes, std::memory_order_relaxed);
+    if (bytes != 0 && TotalBytes() > bytes) {
+        PurgeTo(bytes);
+    }
+}
+
+size_t EgMemory::GetBudget() {
+    return state().fBudget.load(std::memory_order_relaxed);
+}
+
+int EgMemory::RegisterPurgeCallback(PurgeCallback callback) {
+    MemoryState& s = state();
+    std::lock_guard<std::recursive_mutex> lock(s.fPurgeMutex);
+    const int id = s.fNextId++;
+    s.fPurgeCallbacks.push_back({id, std::move(callback)});
+    return id;
+}
+
+void EgMemory::UnregisterPurgeCallback(int id) {
+    MemoryState& s = state();
+    std::lock_guard<std::recursive_mutex> lock(s.fPurgeMutex);
+    s.fPurgeCallbacks.erase(std::remove_if(s.fPurgeCallbacks.begin(), s.fPurgeCallbacks.end(),
+                                           [id](const PurgeEntry& entry) { return entry.fId == id; }),
+                            s.fPurgeCallbacks.end());
+}
+
+size_t EgMemory::PurgeTo(size_t targetBytes) {
+    MemoryState& s = state();
+    // 同一时刻只有一个线程执行清理，已经有线程在清理时直接返回，不等待
+    std::unique_lock<std::recursive_mutex> lock(s.fPurgeMutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return 0;
+    }
+    const bool wasInPurge = gInPurge;
+    gInPurge = true;
+
+    // fPurgeMutex 是递归锁，回调可以在本线程注销自己或其他回调，列表会随之移动。
+    // 因此先记下本轮要调用的 ID，每次按 ID 重新查找：已注销的跳过，其余的不会因移动而漏掉
+    std::vector<int> ids;
+    ids.reserve(s.fPurgeCallbacks.size());
+    for (const PurgeEntry& entry : s.fPurgeCallbacks) {
+        ids.push_back(entry.fId);
+    }
+
+    size_t freed = 0;
+    for (int id : ids) {
+        const size_t total = TotalBytes();
+        if (total <= targetBytes) {
+            break;
+        }
+        auto it = std::find_if(s.fPurgeCallbacks.begin(), s.fPurgeCallbacks.end(),
+                               [id](const PurgeEntry& entry) { return entry.fId == id; });
+        if (it == s.fPurgeCallbacks.end()) {
+            continue;
+        }
+        // 拷贝一份，回调里注销自己也不会影响正在执行的对象
+        PurgeCallback callback = it->fCallback;
+        freed += callback(total - targetBytes);
+    }
+
+    gInPurge = wasInPurge;
+    return freed;
+}
+
+size_t EgMemory::PurgeIfOverBudget() {
+    MemoryState& s = state();
+    if (gInPurge || !s.fPurgePending.load(std::memory_order_relaxed)) {
+        return 0;
+    }
+    s.fPurgePending.store(false, std::memory_order_relaxed);
+    const size_t budget = s.fBudget.load(std::memory_order_relaxed);
+    if (budget == 0 || TotalBytes() <= budget) {
+        return 0;
+    }
+    return PurgeTo(budget);
+}
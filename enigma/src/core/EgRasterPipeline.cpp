@@ -0,0 +1,367 @@
+#include "src/core/EgRasterPipeline.h"
+
+#include "include/core/EgColorSpace.h"
+#include "include/utils/EgTrace.h"
+
+#include "src/base/EgVx.h"
+#include "src/core/EgFrameStatsPriv.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace {
+
+using F = egvx::Vec<EgRasterPipeline::kStride, float>;
+using I32 = egvx::Vec<EgRasterPipeline::kStride, int32_t>;
+using U32 = egvx::Vec<EgRasterPipeline::kStride, uint32_t>;
+
+}  // namespace
+
+/**
+ * @brief 一批像素的状态，tail 为 0 表示整批 kStride 个像素都有效
+ */
+struct EgRasterPipelineParams {
+    F       r, g, b, a;
+    int     dx, dy;
+    int     tail;
+};
+
+namespace {
+
+using Params = EgRasterPipelineParams;
+using StageFn = void (*)(Params*, const void*);
+
+#define STAGE(name) static void name##_stage(Params* p, const void* ctx)
+
+static F from_byte(const U32& v) {
+    return egvx::cast<float>(v & 0xff) * (1.0f / 255.0f);
+}
+
+static U32 to_byte(const F& v) {
+    return egvx::cast<uint32_t>(egvx::cast<int32_t>(egvx::pin(v, F(0.0f), F(1.0f)) * 255.0f + 0.5f));
+}
+
+STAGE(load_8888) {
+    auto mem = static_cast<const EgRasterPipeline_MemoryCtx*>(ctx);
+    const uint32_t* src = static_cast<const uint32_t*>(mem->pixels) + (size_t)p->dy * mem->stride + p->dx;
+    U32 px;
+    if (p->tail == 0) {
+        px = U32::Load(src);
+    } else {
+        uint32_t tmp[EgRasterPipeline::kStride] = {};
+        std::copy(src, src + p->tail, tmp);
+        px = U32::Load(tmp);
+    }
+    p->r = from_byte(px);
+    p->g = from_byte(px >> 8);
+    p->b = from_byte(px >> 16);
+    p->a = from_byte(px >> 24);
+}
+
+STAGE(store_8888) {
+    auto mem = static_cast<const EgRasterPipeline_MemoryCtx*>(ctx);
+    uint32_t* dst = static_cast<uint32_t*>(mem->pixels) + (size_t)p->dy * mem->stride + p->dx;
+    U32 px = to_byte(p->r) | (to_byte(p->g) << 8) | (to_byte(p->b) << 16) | (to_byte(p->a) << 24);
+    if (p->tail == 0) {
+        px.store(dst);
+    } else {
+        uint32_t tmp[EgRasterPipeline::kStride];
+        px.store(tmp);
+        std::copy(tmp, tmp + p->tail, dst);
+    }
+}
+
+STAGE(load_f32) {
+    auto mem = static_cast<const EgRasterPipeline_MemoryCtx*>(ctx);
+    const float* src = static_cast<const float*>(mem->pixels) + ((size_t)p->dy * mem->stride + p->dx) * 4;
+    float tmp[4 * EgRasterPipeline::kStride] = {};
+    std::copy(src, src + 4 * (p->tail ? p->tail : EgRasterPipeline::kStride), tmp);
+    egvx::strided_load4(tmp, p->r, p->g, p->b, p->a);
+}
+
+STAGE(store_f32) {
+    auto mem = static_cast<const EgRasterPipeline_MemoryCtx*>(ctx);
+    float* dst = static_cast<float*>(mem->pixels) + ((size_t)p->dy * mem->stride + p->dx) * 4;
+    const int count = p->tail ? p->tail : EgRasterPipeline::kStride;
+    for (int i = 0; i < count; ++i) {
+        dst[4 * i + 0] = p->r[i];
+        dst[4 * i + 1] = p->g[i];
+        dst[4 * i + 2] = p->b[i];
+        dst[4 * i + 3] = p->a[i];
+    }
+}
+
+STAGE(premul) {
+    p->r = p->r * p->a;
+    p->g = p->g * p->a;
+    p->b = p->b * p->a;
+}
+
+STAGE(unpremul) {
+    F scale = egvx::if_then_else(p->a == 0.0f, F(0.0f), 1.0f / p->a);
+    p->r = p->r * scale;
+    p->g = p->g * scale;
+    p->b = p->b * scale;
+}
+
+STAGE(clamp_01) {
+    p->r = egvx::pin(p->r, F(0.0f), F(1.0f));
+    p->g = egvx::pin(p->g, F(0.0f), F(1.0f));
+    p->b = egvx::pin(p->b, F(0.0f), F(1.0f));
+    p->a = egvx::pin(p->a, F(0.0f), F(1.0f));
+}
+
+STAGE(matrix_4x5) {
+    const float* m = static_cast<const EgRasterPipeline_MatrixCtx*>(ctx)->m;
+    F r = p->r, g = p->g, b = p->b, a = p->a;
+    p->r = r * m[ 0] + g * m[ 1] + b * m[ 2] + a * m[ 3] + m[ 4];
+    p->g = r * m[ 5] + g * m[ 6] + b * m[ 7] + a * m[ 8] + m[ 9];
+    p->b = r * m[10] + g * m[11] + b * m[12] + a * m[13] + m[14];
+    p->a = r * m[15] + g * m[16] + b * m[17] + a * m[18] + m[19];
+}
+
+/**
+ * @brief 四面体插值
+ *
+ * 单位立方体按 r/g/b 小数部分的大小顺序切成 6 个四面体，每个像素只需取 4 个顶点
+ * （三线性插值需要 8 个）：
+ *   c = c000 + wMax * (v1 - c000) + wMid * (v2 - v1) + wMin * (c111 - v2)
+ * 其中 v1 沿最大分量的轴走一步，v2 再沿次大分量的轴走一步。
+ */
+STAGE(lut_3d) {
+    auto lut = static_cast<const EgRasterPipeline_Lut3DCtx*>(ctx);
+    const int size = lut->size;
+    const float maxIndex = (float)(size - 1);
+
+    F fr = egvx::pin(p->r, F(0.0f), F(1.0f)) * maxIndex;
+    F fg = egvx::pin(p->g, F(0.0f), F(1.0f)) * maxIndex;
+    F fb = egvx::pin(p->b, F(0.0f), F(1.0f)) * maxIndex;
+
+    // 最后一格的下界取 size - 2，使 +1 的顶点不越界，小数部分相应变为 1
+    I32 ir = egvx::min(egvx::cast<int32_t>(fr), size - 2);
+    I32 ig = egvx::min(egvx::cast<int32_t>(fg), size - 2);
+    I32 ib = egvx::min(egvx::cast<int32_t>(fb), size - 2);
+    fr = fr - egvx::cast<float>(ir);
+    fg = fg - egvx::cast<float>(ig);
+    fb = fb - egvx::cast<float>(ib);
+
+    const int strideR = 3;
+    const int strideG = 3 * size;
+    const int strideB = 3 * size * size;
+
+    F wMax = egvx::max(fr, egvx::max(fg, fb));
+    F wMin = egvx::min(fr, egvx::min(fg, fb));
+    F wMid = fr + fg + fb - wMax - wMin;
+
+    I32 maxStride = egvx::if_then_else(fr == wMax, I32(strideR),
+                    egvx::if_then_else(fg == wMax, I32(strideG), I32(strideB)));
+    I32 minStride = egvx::if_then_else(fb == wMin, I32(strideB),
+                    egvx::if_then_else(fg == wMin, I32(strideG), I32(strideR)));
+    // 平局时 maxStride 按 r、g、b 的顺序选，minStride 按 b、g、r 的顺序选，
+    // 只有三个分量全相等时两者才可能冲突，而那时分别选中 r 与 b，仍是不同的轴
+
+    I32 base = ir * strideR + ig * strideG + ib * strideB;
+    I32 v1 = base + maxStride;
+    I32 v3 = base + (strideR + strideG + strideB);
+    I32 v2 = v3 - minStride;
+
+    // 没有可依赖的 gather 指令，先把下标存出来逐通道取值，再整批装回寄存器
+    int32_t idx[4][EgRasterPipeline::kStride];
+    base.store(idx[0]);
+    v1.store(idx[1]);
+    v2.store(idx[2]);
+    v3.store(idx[3]);
+
+    float texels[4][3][EgRasterPipeline::kStride];
+    for (int v = 0; v < 4; ++v) {
+        for (int i = 0; i < EgRasterPipeline::kStride; ++i) {
+            const float* t = lut->table + idx[v][i];
+            texels[v][0][i] = t[0];
+            texels[v][1][i] = t[1];
+            texels[v][2][i] = t[2];
+        }
+    }
+
+    F out[3];
+    for (int c = 0; c < 3; ++c) {
+        F c0 = F::Load(texels[0][c]);
+        F c1 = F::Load(texels[1][c]);
+        F c2 = F::Load(texels[2][c]);
+        F c3 = F::Load(texels[3][c]);
+        out[c] = c0 + wMax * (c1 - c0) + wMid * (c2 - c1) + wMin * (c3 - c2);
+    }
+    p->r = out[0];
+    p->g = out[1];
+    p->b = out[2];
+}
+
+/**
+ * @brief 计算系数，取值与 EgBlendModeCoeff 一一对应
+ */
+static F blend_coeff(int coeff, const F& s, const F& sa, const F& d, const F& da) {
+    switch (coeff) {
+        case 0:  return F(0.0f);    // gZero
+        case 1:  return F(1.0f);    // gOne
+        case 2:  return s;          // gSC
+        case 3:  return 1.0f - s;   // gISC
+        case 4:  return d;          // gDC
+        case 5:  return 1.0f - d;   // gIDC
+        case 6:  return sa;         // gSA
+        case 7:  return 1.0f - sa;  // gISA
+        case 8:  return da;         // gDA
+        case 9:  return 1.0f - da;  // gIDA
+        default: return F(0.0f);
+    }
+}
+
+STAGE(blend_color) {
+    auto blend = static_cast<const EgRasterPipeline_BlendColorCtx*>(ctx);
+    const F sa(blend->color[3]);
+    const F da = p->a;
+    F* channels[4] = {&p->r, &p->g, &p->b, &p->a};
+    for (int c = 0; c < 4; ++c) {
+        const F s(blend->color[c]);
+        const F d = *channels[c];
+        F result = s * blend_coeff(blend->srcCoeff, s, sa, d, da) +
+                   d * blend_coeff(blend->dstCoeff, s, sa, d, da);
+        *channels[c] = egvx::pin(result, F(0.0f), F(1.0f));
+    }
+}
+
+static F parametric(const EgTransferFunction* tf, const F& v) {
+    U32 bits = egvx::bit_pun<U32>(v);
+    U32 sign = bits & 0x8000'0000;
+    F x = egvx::bit_pun<F>(bits ^ sign);
+
+    F curve = egvx::approx_powf(egvx::max(x * tf->a + tf->b, 0.0f), tf->g) + tf->e;
+    F result = egvx::if_then_else(x < tf->d, x * tf->c + tf->f, curve);
+    return egvx::bit_pun<F>(egvx::bit_pun<U32>(result) | sign);
+}
+
+STAGE(parametric) {
+    auto tf = static_cast<const EgTransferFunction*>(ctx);
+    p->r = parametric(tf, p->r);
+    p->g = parametric(tf, p->g);
+    p->b = parametric(tf, p->b);
+}
+
+// SMPTE ST 2084，10000 nits 对应 1.0 / kPQScale，参考白 203 nits 对应 1.0
+static constexpr float kPQ_m1 = 2610.0f / 16384.0f;
+static constexpr float kPQ_m2 = 2523.0f / 4096.0f * 128.0f;
+static constexpr float kPQ_c1 = 3424.0f / 4096.0f;
+static constexpr float kPQ_c2 = 2413.0f / 4096.0f * 32.0f;
+static constexpr float kPQ_c3 = 2392.0f / 4096.0f * 32.0f;
+static constexpr float kPQScale = 10000.0f / 203.0f;
+
+static F pq(const F& v) {
+    F e = egvx::approx_powf(egvx::max(v, 0.0f), 1.0f / kPQ_m2);
+    F num = egvx::max(e - kPQ_c1, 0.0f);
+    F den = kPQ_c2 - kPQ_c3 * e;
+    return egvx::approx_powf(num / den, 1.0f / kPQ_m1) * kPQScale;
+}
+
+static F inv_pq(const F& v) {
+    F y = egvx::approx_powf(egvx::max(v * (1.0f / kPQScale), 0.0f), kPQ_m1);
+    return egvx::approx_powf((kPQ_c1 + kPQ_c2 * y) / (1.0f + kPQ_c3 * y), kPQ_m2);
+}
+
+STAGE(pq) {
+    p->r = pq(p->r);
+    p->g = pq(p->g);
+    p->b = pq(p->b);
+}
+
+STAGE(inv_pq) {
+    p->r = inv_pq(p->r);
+    p->g = inv_pq(p->g);
+    p->b = inv_pq(p->b);
+}
+
+// ARIB STD-B67 (BT.2100 HLG)，不含 OOTF；按 BT.2408 把 75% 信号（参考白）映射到 1.0
+static constexpr float kHLG_a = 0.17883277f;
+static constexpr float kHLG_b = 0.28466892f;
+static constexpr float kHLG_c = 0.55991073f;
+static constexpr float kHLGScale = 3.77397f;   // 1 / hlg(0.75)
+static constexpr float kLog2E = 1.44269504f;
+static constexpr float kLn2 = 0.69314718f;
+
+static F hlg(const F& v) {
+    F x = egvx::max(v, 0.0f);
+    F low  = x * x * (1.0f / 3.0f);
+    F high = (egvx::approx_pow2((x - kHLG_c) * (kLog2E / kHLG_a)) + kHLG_b) * (1.0f / 12.0f);
+    return egvx::if_then_else(x <= 0.5f, low, high) * kHLGScale;
+}
+
+static F inv_hlg(const F& v) {
+    F l = egvx::max(v * (1.0f / kHLGScale), 0.0f);
+    F low  = egvx::sqrt(3.0f * l);
+    F high = kHLG_a * kLn2 * egvx::approx_log2(egvx::max(12.0f * l - kHLG_b, 1e-6f)) + kHLG_c;
+    return egvx::if_then_else(l <= 1.0f / 12.0f, low, high);
+}
+
+STAGE(hlg) {
+    p->r = hlg(p->r);
+    p->g = hlg(p->g);
+    p->b = hlg(p->b);
+}
+
+STAGE(inv_hlg) {
+    p->r = inv_hlg(p->r);
+    p->g = inv_hlg(p->g);
+    p->b = inv_hlg(p->b);
+}
+
+STAGE(gamut_3x3) {
+    const float* m = static_cast<const EgRasterPipeline_GamutCtx*>(ctx)->m;
+    F r = p->r, g = p->g, b = p->b;
+    p->r = r * m[0] + g * m[1] + b * m[2];
+    p->g = r * m[3] + g * m[4] + b * m[5];
+    p->b = r * m[6] + g * m[7] + b * m[8];
+}
+
+#undef STAGE
+
+static const StageFn gStageFns[] = {
+#define M(op) op##_stage,
+    EG_RASTER_PIPELINE_OPS(M)
+#undef M
+};
+
+static_assert(std::size(gStageFns) == kEgRasterPipelineOpCount, "");
+
+}  // namespace
+
+void EgRasterPipeline::run(int x, int y, int width, int height) {
+    if (fNumStages == 0 || width <= 0 || height <= 0) {
+        return;
+    }
+    EG_TRACE_EVENT1("raster", "EgRasterPipeline::run", "pixels", (int64_t)width * height);
+
+    // 阶段表只解析一次，之后每批像素只是顺序调用函数指针
+    if (fProgram == nullptr) {
+        fProgram = fAlloc->makeArrayDefault<Instruction>(fNumStages);
+        int index = fNumStages;
+        for (const StageList* stage = fStages; stage != nullptr; stage = stage->fPrev) {
+            fProgram[--index] = {gStageFns[(int)stage->fOp], stage->fCtx};
+        }
+        EgFrameStats_Add(&EgFrameStatsCounters::fPipelinesBuilt);
+    }
+    for (const StageList* stage = fStages; stage != nullptr; stage = stage->fPrev) {
+        if (stage->fOp == EgRasterPipelineOp::blend_color) {
+            auto blend = static_cast<const EgRasterPipeline_BlendColorCtx*>(stage->fCtx);
+            EgFrameStats_AddPixelsBlended((EgBlendMode)blend->mode, (uint64_t)width * height);
+        }
+    }
+
+    Params params;
+    for (int dy = y; dy < y + height; ++dy) {
+        params.dy = dy;
+        for (int dx = x; dx < x + width; dx += kStride) {
+            params.dx = dx;
+            params.tail = std::min(x + width - dx, kStride) == kStride ? 0 : x + width - dx;
+            for (const Instruction* inst = fProgram; inst != fProgram + fNumStages; ++inst) {
+                inst->fFn(&params, inst->fCtx);
+            }
+        }
+    }
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "include/private/base/EgAssert.h"
+
+#include "src/base/EgArenaAlloc.h"
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief 光栅流水线的阶段
+ *
+ * 每个阶段对一批（kStride 个）像素的 r/g/b/a 浮点寄存器做一次变换，
+ * 整条流水线在同一批像素上依次执行所有阶段，像素只从内存读写一次。
+ */
+#define EG_RASTER_PIPELINE_OPS(M)   \
+    M(load_8888)   M(store_8888)    \
+    M(load_f32)    M(store_f32)     \
+    M(premul)      M(unpremul)      \
+    M(clamp_01)                     \
+    M(matrix_4x5)  M(lut_3d)        \
+    M(blend_color)                  \
+    M(parametric)                   \
+    M(pq)          M(inv_pq)        \
+    M(hlg)         M(inv_hlg)       \
+    M(gamut_3x3)
+
+enum class EgRasterPipelineOp {
+#define M(op) op,
+    EG_RASTER_PIPELINE_OPS(M)
+#undef M
+};
+
+static constexpr int kEgRasterPipelineOpCount = 0
+#define M(op) + 1
+    EG_RASTER_PIPELINE_OPS(M)
+#undef M
+    ;
+
+/**
+ * @brief load/store 的上下文，stride 为每行像素数
+ *
+ * - load_8888 / store_8888 : 每像素 4 字节，RGBA 字节序
+ * - load_f32 / store_f32   : 每像素 4 个 float，RGBA 顺序
+ */
+struct EgRasterPipeline_MemoryCtx {
+    void*   pixels;
+    int     stride;
+};
+
+/**
+ * @brief matrix_4x5 的上下文，作用在非预乘颜色上，按行主序存储：
+ *        r' = m[0]*r + m[1]*g + m[2]*b + m[3]*a + m[4]，其余通道依此类推
+ */
+struct EgRasterPipeline_MatrixCtx {
+    float   m[20];
+};
+
+/**
+ * @brief lut_3d 的上下文，作用在非预乘颜色上
+ *
+ * table 为 size^3 个 RGB 三元组，下标为 (b * size + g) * size + r。
+ */
+struct EgRasterPipeline_Lut3DCtx {
+    const float*    table;
+    int             size;
+};
+
+/**
+ * @brief blend_color 的上下文：以常量预乘颜色为源、当前像素为目标做系数混合
+ */
+struct EgRasterPipeline_BlendColorCtx {
+    float   color[4];
+    int     srcCoeff;   // EgBlendModeCoeff
+    int     dstCoeff;   // EgBlendModeCoeff
+    int     mode;       // EgBlendMode，只用于统计
+};
+
+/**
+ * @brief gamut_3x3 的上下文，行主序，作用在线性 rgb 上
+ */
+struct EgRasterPipeline_GamutCtx {
+    float   m[9];
+};
+
+/**
+ * 传递函数阶段：
+ * - parametric       : ctx 为 EgTransferFunction，按参数形式计算，负数按奇函数延拓
+ * - pq / hlg         : 编码值 -> 线性光，1.0 对应参考白
+ * - inv_pq / inv_hlg : 线性光 -> 编码值
+ */
+
+struct EgRasterPipelineParams;
+
+class EgRasterPipeline {
+public:
+    /**
+     * @brief 每批处理的像素数
+     */
+    static constexpr int kStride = 8;
+
+    /**
+     * @param alloc 阶段表和解析后的函数指针表都从 alloc 分配，需比流水线活得久
+     */
+    explicit EgRasterPipeline(EgArenaAlloc* alloc) : fAlloc(alloc) {}
+
+    EgRasterPipeline(const EgRasterPipeline&) = delete;
+    EgRasterPipeline& operator=(const EgRasterPipeline&) = delete;
+
+    /**
+     * @brief 追加一个阶段，ctx 由调用者持有，需在 run 结束前保持有效
+     */
+    void append(EgRasterPipelineOp op, const void* ctx = nullptr) {
+        fStages = fAlloc->make<StageList>(StageList{fStages, op, ctx});
+        ++fNumStages;
+        fProgram = nullptr;
+    }
+
+    /**
+     * @brief 清空阶段，已占用的 alloc 内存要等 alloc 自己 reset 才回收
+     */
+    void reset() {
+        fStages = nullptr;
+        fNumStages = 0;
+        fProgram = nullptr;
+    }
+
+    bool empty() const { return fNumStages == 0; }
+
+    /**
+     * @brief 在 [x, x + width) x [y, y + height) 上执行流水线
+     *
+     * 阶段表在第一次执行时解析为函数指针表并缓存（从 alloc 分配），之后的执行直接复用，
+     * append / reset 之后重新解析。执行会修改缓存，因此不是 const，同一个实例不能在多个线程上同时执行。
+     */
+    void run(int x, int y, int width, int height);
+
+private:
+    using StageFn = void (*)(EgRasterPipelineParams*, const void*);
+
+    /**
+     * @brief 阶段按追加的逆序链接，解析时再反转
+     */
+    struct StageList {
+        StageList*          fPrev;
+        EgRasterPipelineOp  fOp;
+        const void*         fCtx;
+    };
+
+    struct Instruction {
+        StageFn             fFn;
+        const void*         fCtx;
+    };
+
+    EgArenaAlloc*           fAlloc;
+    StageList*              fStages = nullptr;
+    int                     fNumStages = 0;
+    Instruction*            fProgram = nullptr;
+};
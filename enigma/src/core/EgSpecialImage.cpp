@@ -0,0 +1,51 @@
+#include "src/core/EgSpecialImage.h"
+
+EgSp<EgSpecialImage> EgSpecialImage::Make(const EgIRect& bounds) {
+    EgMask mask;
+    mask.fFormat = EgMask::gARGB32_Format;
+    mask.fBounds = bounds;
+    if (bounds.isEmpty() || !mask.allocImage()) {
+        return nullptr;
+    }
+    return Adopt(&mask);
+}
+
+EgSp<EgSpecialImage> EgSpecialImage::Adopt(EgMask* mask) {
+    EgAssert(mask->fFormat == EgMask::gARGB32_Format);
+    if (mask->fImage == nullptr || mask->isEmpty()) {
+        return nullptr;
+    }
+    EgSp<PixelRef> pixels = EgMakeSp<PixelRef>(mask->fImage);
+    uint8_t* base = mask->fImage;
+    mask->fImage = nullptr;
+    return EgMakeSp<EgSpecialImage>(std::move(pixels), base, mask->fBounds, mask->fRowBytes);
+}
+
+EgSp<EgSpecialImage> EgSpecialImage::MakeView(const EgMask& mask) {
+    EgAssert(mask.fFormat == EgMask::gARGB32_Format);
+    if (mask.fImage == nullptr || mask.isEmpty()) {
+        return nullptr;
+    }
+    return EgMakeSp<EgSpecialImage>(nullptr, mask.fImage, mask.fBounds, mask.fRowBytes);
+}
+
+EgMask EgSpecialImage::asMask() const {
+    EgMask mask;
+    mask.fImage    = fBase;
+    mask.fBounds   = fBounds;
+    mask.fRowBytes = fRowBytes;
+    mask.fFormat   = EgMask::gARGB32_Format;
+    return mask;
+}
+
+EgSp<EgSpecialImage> EgSpecialImage::makeOffset(int dx, int dy) const {
+    return EgMakeSp<EgSpecialImage>(fPixels, fBase, fBounds.makeOffsets(dx, dy), fRowBytes);
+}
+
+EgSp<EgSpecialImage> EgSpecialImage::makeSubset(const EgIRect& subset) const {
+    EgIRect bounds;
+    if (!bounds.intersect(fBounds, subset)) {
+        return nullptr;
+    }
+    return EgMakeSp<EgSpecialImage>(fPixels, this->getAddr(bounds.fLeft, bounds.fTop), bounds, fRowBytes);
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "include/core/EgRect.h"
+
+#include "include/core/EgRefCnt.h"
+
+#include "src/core/EgMask.h"
+
+/**
+ * @brief 图像滤镜求值过程中使用的中间图像
+ *
+ * 像素格式固定为预乘的 gARGB32_Format，fBounds 为图像在图层空间中的位置。
+ * 像素内存通过 PixelRef 共享，makeOffset / makeSubset 只生成新的视图而不拷贝像素。
+ */
+class EgSpecialImage : public EgNVRefCnt<EgSpecialImage> {
+public:
+    /**
+     * @brief 分配一块清零的图像
+     * @return bounds 为空或分配失败时返回 nullptr
+     */
+    static EgSp<EgSpecialImage> Make(const EgIRect& bounds);
+
+    /**
+     * @brief 接管 mask 的图像内存，mask.fImage 置空
+     */
+    static EgSp<EgSpecialImage> Adopt(EgMask* mask);
+
+    /**
+     * @brief 引用外部像素而不接管，调用者需保证像素在图像使用期间有效
+     */
+    static EgSp<EgSpecialImage> MakeView(const EgMask& mask);
+
+    const EgIRect& bounds() const { return fBounds; }
+    uint32_t rowBytes() const { return fRowBytes; }
+
+    uint8_t* getAddr(int x, int y) const {
+        EgAssert(fBounds.contains(x, y));
+        return fBase + (size_t)(y - fBounds.fTop) * fRowBytes + (size_t)(x - fBounds.fLeft) * 4;
+    }
+
+    /**
+     * @brief 以 EgMask 的形式访问像素（不转移所有权）
+     */
+    EgMask asMask() const;
+
+    /**
+     * @brief 整体平移后的视图
+     */
+    EgSp<EgSpecialImage> makeOffset(int dx, int dy) const;
+
+    /**
+     * @brief 与 subset 相交部分的视图，不相交时返回 nullptr
+     */
+    EgSp<EgSpecialImage> makeSubset(const EgIRect& subset) const;
+
+    /**
+     * @brief 持有通过 EgMask::AllocImage 分配的像素，计数归零时释放
+     */
+    class PixelRef : public EgNVRefCnt<PixelRef> {
+    public:
+        explicit PixelRef(uint8_t* pixels) : fPixels(pixels) {}
+        ~PixelRef() { EgMask::FreeImage(fPixels); }
+
+    private:
+        uint8_t* fPixels;
+    };
+
+    /**
+     * @param pixels 像素的所有者，为空表示引用外部像素（MakeView）
+     */
+    EgSpecialImage(EgSp<PixelRef> pixels, uint8_t* base, const EgIRect& bounds, uint32_t rowBytes)
+        : fPixels(std::move(pixels))
+        , fBase(base)
+        , fBounds(bounds)
+        , fRowBytes(rowBytes) {}
+
+private:
+    EgSp<PixelRef>              fPixels;
+    uint8_t*                    fBase;
+    EgIRect                     fBounds;
+    uint32_t                    fRowBytes;
+};
@@ -2,52 +2,25 @@
 #include "include/private/base/EgTo.h"
 #include "include/private/base/EgAssert.h"
 
+#include "include/core/EgMemory.h"
 #include "include/core/EgString.h"
 
-#include "src/base/EgSafeMath.h"
+#include "include/private/base/EgSafeMath.h"
 #include "src/base/EgUTF.h"
 #include "src/base/EgUtils.h"
+#include "src/base/EgVx.h"
 
 #include <algorithm>
+#include <charconv>
 #include <cstdio>
 #include <cstring>
 #include <cstdarg>
+#include <cstddef>
 #include <string_view>
 #include <new>
+#include <type_traits>
 #include <utility>
 
-static const size_t kBufferSize = 1024;
-
-struct StringBuffer {
-    char* mData;
-    int mLength;
-};
-
-template <int SIZE>
-static StringBuffer apply_format_string(const char* fmt,
-                                        va_list args,
-                                        char (&buffer)[SIZE],
-                                        EgString* heapBuffer) {
-
-    va_list argsCopy;
-    va_copy(argsCopy, args);
-    int outLen = std::vsnprintf(buffer, SIZE, fmt, args);
-    if (outLen < 0) {
-        va_end(argsCopy);
-        return {buffer, 0};
-    }
-
-    if (outLen < SIZE) {
-        va_end(argsCopy);
-        return {buffer, outLen};
-    }
-
-    heapBuffer->set(nullptr, outLen);
-    char* heapBufferDst = heapBuffer->data();
-    va_end(argsCopy);
-    return {heapBufferDst, outLen};
-}
-
 ///////////////////////////////////////////////////////////////
 
 
@@ -59,8 +32,7 @@ bool EgStrEndsWith(const char str[], const char suffixStr[]) {
     size_t suffixLen = strlen(suffixStr);
 
 
-    return  strLen >= suffixLen &&
-                !strncmp(str + strLen - suffixLen, suffixStr, suffixLen);
+    return EgStrEndsWith(str, strLen, suffixStr, suffixLen);
 }
 
 bool EgStrEndsWith(const char str[], const char suffixChar) {
@@ -71,6 +43,202 @@ bool EgStrEndsWith(const char str[], const char suffixChar) {
     return strLen > 0 && str[strLen - 1] == suffixChar;
 }
 
+namespace {
+
+using Bytes16 = egvx::Vec<16, uint8_t>;
+
+// 子串长度达到该值后，首尾字节过滤要限制候选校验的开销，超出时改用 Two-Way，
+// 否则在病态输入上会退化为 O(n * m)
+static constexpr size_t kTwoWayMinNeedle = 32;
+
+// 放弃首尾字节过滤的返回值
+static constexpr ptrdiff_t kGiveUp = -2;
+
+/**
+ * @brief 首尾字节 SIMD 过滤：一次检查 16 个起点，首字节和末字节都相等的起点再比较中间部分
+ * @param giveUpAt 非空时限制校验开销：比较过的字节数超过扫描字节数的常数倍时返回 kGiveUp，
+ *                 并写入尚未排除的第一个起点
+ * @note needleLen >= 2
+ */
+static ptrdiff_t find_first_last(const char* str, size_t strLen, const char* needle, size_t needleLen,
+                                 size_t* giveUpAt) {
+    const size_t last = needleLen - 1;
+    const Bytes16 firstByte((uint8_t)needle[0]);
+    const Bytes16 lastByte((uint8_t)needle[last]);
+    size_t verified = 0;
+
+    size_t i = 0;
+    for (; i + last + 16 <= strLen; i += 16) {
+        Bytes16 candidates = (Bytes16::Load(str + i) == firstByte) &
+                             (Bytes16::Load(str + i + last) == lastByte);
+        if (!egvx::any(candidates)) {
+            continue;
+        }
+        if (giveUpAt && verified > 4 * i + 1024) {
+            *giveUpAt = i;
+            return kGiveUp;
+        }
+        uint8_t lanes[16];
+        candidates.store(lanes);
+        for (size_t k = 0; k < 16; ++k) {
+            if (lanes[k]) {
+                if (!memcmp(str + i + k + 1, needle + 1, last - 1)) {
+                    return (ptrdiff_t)(i + k);
+                }
+                verified += needleLen;
+            }
+        }
+    }
+    // 尾部不足 16 个起点，逐个比较的开销不超过 16 * needleLen
+    for (; i + last < strLen; ++i) {
+        if (str[i] == needle[0] && str[i + last] == needle[last] &&
+            !memcmp(str + i + 1, needle + 1, last - 1)) {
+            return (ptrdiff_t)i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief 求 x 在字典序（reversed 时为逆字典序）下的最大后缀
+ * @param period 写入该后缀的周期
+ * @return 最大后缀起点的前一个位置，可能为 -1
+ */
+static ptrdiff_t maximal_suffix(const uint8_t* x, ptrdiff_t m, ptrdiff_t* period, bool reversed) {
+    ptrdiff_t ms = -1;
+    ptrdiff_t j = 0;
+    ptrdiff_t k = 1;
+    ptrdiff_t p = 1;
+    while (j + k < m) {
+        uint8_t a = x[j + k];
+        uint8_t b = x[ms + k];
+        if (reversed) {
+            std::swap(a, b);
+        }
+        if (a < b) {
+            j += k;
+            k = 1;
+            p = j - ms;
+        } else if (a == b) {
+            if (k != p) {
+                ++k;
+            } else {
+                j += p;
+                k = 1;
+            }
+        } else {
+            ms = j;
+            j = ms + 1;
+            k = p = 1;
+        }
+    }
+    *period = p;
+    return ms;
+}
+
+/**
+ * @brief Crochemore-Perrin Two-Way 查找，O(n + m) 时间、O(1) 额外空间
+ *
+ * 子串在临界分解点 ell 处切成 x[0, ell] 和 x[ell + 1, m)，先从左到右比较右半，
+ * 再从右到左比较左半；子串有周期 per 时用 memory 记住已经匹配过的前缀，避免重复比较。
+ */
+static ptrdiff_t find_two_way(const char* str, size_t strLen, const char* needle, size_t needleLen) {
+    const uint8_t* x = (const uint8_t*)needle;
+    const uint8_t* y = (const uint8_t*)str;
+    const ptrdiff_t m = (ptrdiff_t)needleLen;
+    const ptrdiff_t n = (ptrdiff_t)strLen;
+
+    ptrdiff_t p, q;
+    ptrdiff_t i = maximal_suffix(x, m, &p, false);
+    ptrdiff_t j = maximal_suffix(x, m, &q, true);
+    ptrdiff_t ell, per;
+    if (i > j) {
+        ell = i;
+        per = p;
+    } else {
+        ell = j;
+        per = q;
+    }
+
+    if (!memcmp(x, x + per, ell + 1)) {
+        ptrdiff_t memory = -1;
+        j = 0;
+        while (j <= n - m) {
+            i = std::max(ell, memory) + 1;
+            while (i < m && x[i] == y[i + j]) {
+                ++i;
+            }
+            if (i >= m) {
+                i = ell;
+                while (i > memory && x[i] == y[i + j]) {
+                    --i;
+                }
+                if (i <= memory) {
+                    return j;
+                }
+                j += per;
+                memory = m - per - 1;
+            } else {
+                j += i - ell;
+                memory = -1;
+            }
+        }
+    } else {
+        per = std::max(ell + 1, m - ell - 1) + 1;
+        j = 0;
+        while (j <= n - m) {
+            i = ell + 1;
+            while (i < m && x[i] == y[i + j]) {
+                ++i;
+            }
+            if (i >= m) {
+                i = ell;
+                while (i >= 0 && x[i] == y[i + j]) {
+                    --i;
+                }
+                if (i < 0) {
+                    return j;
+                }
+                j += per;
+            } else {
+                j += i - ell;
+            }
+        }
+    }
+    return -1;
+}
+
+}  // namespace
+
+int EgStrFind(const char str[], size_t strLen, const char substr[], size_t substrLen) {
+    EgAssert(str != nullptr || strLen == 0);
+    EgAssert(substr != nullptr || substrLen == 0);
+
+    if (substrLen == 0) {
+        return 0;
+    }
+    if (substrLen > strLen) {
+        return -1;
+    }
+    ptrdiff_t found;
+    if (substrLen == 1) {
+        const char* p = (const char*)memchr(str, substr[0], strLen);
+        found = p ? p - str : -1;
+    } else if (substrLen < kTwoWayMinNeedle) {
+        found = find_first_last(str, strLen, substr, substrLen, nullptr);
+    } else {
+        size_t resume = 0;
+        found = find_first_last(str, strLen, substr, substrLen, &resume);
+        if (found == kGiveUp) {
+            found = find_two_way(str + resume, strLen - resume, substr, substrLen);
+            if (found >= 0) {
+                found += resume;
+            }
+        }
+    }
+    return found >= 0 ? EgToInt(found) : -1;
+}
+
 int EgStrStartsWithOneOf(const char str[], const char prefixes[]) {
     int index = 0;
     do {
@@ -84,34 +252,63 @@ int EgStrStartsWithOneOf(const char str[], const char prefixes[]) {
     return -1;
 }
 
+// "00" "01" ... "99"，每次除以 100 写两位，除法次数减半
+static const char gDigitPairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
 /**
- * @brief 将 int32_t 类型的数字转换为字符串
- * @param dst 字符串缓冲区
+ * @brief 十进制位数，0 算一位
+ */
+static int count_digits(uint64_t value) {
+    int digits = 1;
+    for (;;) {
+        if (value < 10) return digits;
+        if (value < 100) return digits + 1;
+        if (value < 1000) return digits + 2;
+        if (value < 10000) return digits + 3;
+        value /= 10000;
+        digits += 4;
+    }
+}
+
+/**
+ * @brief 从 end 往前写 value 的十进制数字，end 之前必须恰好留出 count_digits(value) 个字符
+ */
+template <typename T>
+static void write_digits_backward(char* end, T value) {
+    while (value >= 100) {
+        unsigned pair = (unsigned)(value % 100) * 2;
+        value /= 100;
+        end -= 2;
+        memcpy(end, gDigitPairs + pair, 2);
+    }
+    if (value >= 10) {
+        memcpy(end - 2, gDigitPairs + (unsigned)value * 2, 2);
+    } else {
+        end[-1] = (char)('0' + value);
+    }
+}
+
+/**
+ * @brief 将 uint32_t 类型的数字转换为字符串
+ * @param dst 字符串缓冲区，至少 kEgStrAppendU32_MaxSize 个字符
  * @param dec 要转换的数字
- * @return 转换后的字符串
- * @note 该函数不会检查缓冲区是否足够大
+ * @return 写入内容之后的位置
  * @note 该函数不会检查 dst 是否为 nullptr
  */
 char* EgStrAppendU32(char dst[], uint32_t dec) {
-    // 10 位数字的最大值是 4294967295
-    char buffer[kEgStrAppendU32_MaxSize];
-    // 从后往前填充数字
-    char* p = buffer + sizeof(buffer);
-    do {
-        // 取余数
-        *--p =  EgToU8('0' + dec % 10);
-        // 取整数
-        dec /= 10;
-    } while (dec != 0);
-
-    EgAssert(p >= buffer);
-    // 计算拷贝的长度
-    size_t cp_len = buffer + sizeof(buffer) - p;
-    // 拷贝到目标缓冲区
-    memcpy(dst, p, cp_len);
-    // 移动目标缓冲区指针
-    dst += cp_len;
-
+    // 先算出位数再从后往前写，省去临时缓冲区和拷贝
+    dst += count_digits(dec);
+    write_digits_backward(dst, dec);
     return dst;
 }
 
@@ -136,33 +333,26 @@ char* EgStrAppendS32(char dst[], int32_t dec) {
 
 /**
  * @brief 将 uint64_t 类型的数字转换为字符串
- * @param dst 字符串缓冲区
+ * @param dst 字符串缓冲区，至少 kEgStrAppendU64_MaxSize 个字符
  * @param dec 要转换的数字
- * @param minDigits 最小位数
- * @return 转换后的字符串
- * @note 该函数不会检查缓冲区是否足够大
+ * @param minDigits 最小位数，不足时前面补 0，超过 kEgStrAppendU64_MaxSize 的部分被忽略
+ * @return 写入内容之后的位置
  * @note 该函数不会检查 dst 是否为 nullptr
- * @note 该函数不会检查 minDigits 是否为负数
  */
 char* EgStrAppendU64(char dst[], uint64_t dec, int minDigits) {
-    char buffer[kEgStrAppendU64_MaxSize];
-    char* p = buffer + sizeof(buffer);
-    do {
-        *--p = EgToU8('0' + (int32_t)(dec % 10));
-        dec /= 10;
-        minDigits--;
-    } while (dec != 0);
-
-    while (minDigits > 0) {
-        *--p = '0';
-        minDigits--;
+    int digits = count_digits(dec);
+    minDigits = std::min(minDigits, kEgStrAppendU64_MaxSize);
+    if (minDigits > digits) {
+        memset(dst, '0', minDigits - digits);
+        dst += minDigits - digits;
+    }
+    dst += digits;
+    // 能放进 32 位时用 32 位除法，比 64 位快得多
+    if (dec <= UINT32_MAX) {
+        write_digits_backward(dst, (uint32_t)dec);
+    } else {
+        write_digits_backward(dst, dec);
     }
-
-    EgAssert(p >= buffer);
-    size_t cp_len = buffer + sizeof(buffer) - p;
-    memcpy(dst, p, cp_len);
-    dst += cp_len;
-
     return dst;
 }
 
@@ -185,41 +375,38 @@ char* EgStrAppendS64(char dst[], int64_t dec, int minDigits) {
 
 /**
  * @brief 将 EgScalar 类型的数字转换为字符串
- * @param dst 字符串缓冲区
+ * @param dst 字符串缓冲区，至少 kEgStrAppendScalar_MaxSize 个字符
  * @param dec 要转换的数字
- * @return 转换后的字符串
- * @note 该函数不会检查缓冲区是否足够大
+ * @return 写入内容之后的位置
+ * @note 输出能精确读回原值的最短十进制表示，例如 0.1f 输出 "0.1"，1e20f 输出 "1e+20"
  * @note 该函数不会检查 dst 是否为 nullptr
  */
 char* EgStrAppendScalar(char dst[], EgScalar dec) {
     if (EgScalarIsNaN(dec)) {
-        strcpy(dst, "NaN");
+        memcpy(dst, "NaN", 3);
         return dst + 3;
     }
 
     if (!EgScalarIsFinite(dec)) {
         if (dec > 0) {
-            strcpy(dst, "Inf");
+            memcpy(dst, "Inf", 3);
             return dst + 3;
         } else {
-            strcpy(dst, "-Inf");
+            memcpy(dst, "-Inf", 4);
             return dst + 4;
         }
     }
 
-    static const char gFormat[] = "%.8g";
-    char buffer[kEgStrAppendScalar_MaxSize + 1];
-    int len = snprintf(buffer, sizeof(buffer), gFormat, dec);
-    memcpy(dst, buffer, len);
-    EgAssert(len <= kEgStrAppendScalar_MaxSize);
-    return dst + len;
+    // 最短往返格式（Ryu 算法），不经过 printf 的格式解析和 locale，
+    // 在定点和科学计数法中取较短的一种，最长为 "-1.17549435e-38" 共 15 个字符
+    std::to_chars_result result = std::to_chars(dst, dst + kEgStrAppendScalar_MaxSize, dec);
+    EgAssert(result.ec == std::errc());
+    return result.ptr;
 }
 
 ///////////////////////////////////////////////////////////////
 
-const EgString::Rec EgString::kEmptyRec(0, 0);
-
-#define SizeOfRec()  (kEmptyRec.data() - (char*)&kEmptyRec)
+static_assert(sizeof(EgString) == 24, "EgString should stay three words");
 
 /**
  * @brief 将size_t类型的值转换为uint32_t类型的值
@@ -252,26 +439,28 @@ static size_t check_add32(size_t base, size_t extra) {
 }
 
 /**
- * @brief 创建一个 EgString::Rec 对象
- * @param str 字符串
+ * @brief 在堆上创建一个 EgString::Rec 对象，引用计数为 1
+ * @param str 字符串，为 nullptr 时只分配不拷贝
  * @param len 字符串长度
  * @return 创建的 EgString::Rec 对象
  */
-std::shared_ptr<EgString::Rec> EgString::Rec::Make(const char str[], size_t len) {
-    if (len == 0) {
-        return MakeEmpty();
-    }
+EgString::Rec* EgString::Rec::Make(const char str[], size_t len, size_t capacity) {
+    EgAssert(len <= capacity);
+    static_assert(std::is_standard_layout_v<Rec>);
+    constexpr size_t kHeaderSize = offsetof(Rec, mBeginningOfData);
     EgSafeMath safe;
     uint32_t stringLen = safe.castTo<uint32_t>(len);
-    size_t allocationSize = safe.add(len, SizeOfRec() + sizeof(char));
+    size_t allocationSize = safe.add(capacity, kHeaderSize + sizeof(char));
     allocationSize = safe.alignUp(allocationSize, 4);
+    // 对齐多出来的字节也计入容量
+    uint32_t storageCapacity = safe.castTo<uint32_t>(allocationSize - kHeaderSize - sizeof(char));
     EgAssert(safe.ok());
 
-    void* memory = ::operator new(allocationSize);
-    std::shared_ptr<Rec> rec(new(memory) Rec(stringLen, 1), [memory](Rec* rec) {
-        rec->unref();
-        ::operator delete(memory);
-    });
+    void* memory = EgMemory::Malloc(gStrings_EgMemorySubsystem, allocationSize);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    Rec* rec = new(memory) Rec(stringLen, storageCapacity, 1);
     if (str) {
         memcpy(rec->data(), str, len);
     }
@@ -279,26 +468,16 @@ std::shared_ptr<EgString::Rec> EgString::Rec::Make(const char str[], size_t len)
     return rec;
 }
 
-std::shared_ptr<EgString::Rec> EgString::Rec::MakeEmpty() {
-    return std::make_shared<Rec>(0, 0);
-}
-
 void EgString::Rec::ref() const {
-    if (this == &EgString::kEmptyRec) {
-        return;
-    }
     EgAssertRelease(mRefCnt.fetch_add(1, std::memory_order_relaxed));
 }
 
 void EgString::Rec::unref() const {
-    if (this == &EgString::kEmptyRec) {
-        return;
-    }
-    int32_t oldRefCnt = mRefCnt.fetch_sub(1, std::memory_order_acq_rel);
+    uint32_t oldRefCnt = mRefCnt.fetch_sub(1, std::memory_order_acq_rel);
     EgAssert(oldRefCnt);
     if (oldRefCnt == 1) {
         this->~Rec();
-        ::operator delete(const_cast<Rec*>(this));
+        EgMemory::Free(gStrings_EgMemorySubsystem, const_cast<Rec*>(this));
     }
 }
 
@@ -308,41 +487,105 @@ bool EgString::Rec::unique() const {
 
 ///////////////////////////////////////////////////////////////
 
-EgString::EgString() : mRec(Rec::MakeEmpty()) {}
+/**
+ * @brief 用 str 初始化存储，调用前存储中不能持有 Rec
+ * @note 长度不超过 kInlineCapacity 时直接写入内联缓冲区，不分配内存
+ */
+void EgString::initWith(const char str[], size_t len) {
+    if (len <= kInlineCapacity) {
+        if (str && len) {
+            memcpy(mStorage, str, len);
+        }
+        this->setInlineLength(len);
+    } else {
+        this->setHeapRec(Rec::Make(str, len, len));
+    }
+}
+
+/**
+ * @brief 释放持有的 Rec 并回到空的内联状态
+ */
+void EgString::release() {
+    if (this->isHeap()) {
+        this->heapRec()->unref();
+    }
+    this->setInlineLength(0);
+}
+
+/**
+ * @brief 能否在不重新分配的情况下把长度改为 len
+ */
+bool EgString::canWriteInPlace(size_t len) const {
+    if (!this->isHeap()) {
+        return len <= kInlineCapacity;
+    }
+    const Rec* rec = this->heapRec();
+    return rec->unique() && len <= rec->mCapacity;
+}
+
+/**
+ * @brief 修改长度并写入结尾的 '\0'，调用者需先通过 canWriteInPlace 检查
+ */
+void EgString::setLengthInPlace(size_t len) {
+    if (this->isHeap()) {
+        Rec* rec = this->heapRec();
+        rec->data()[len] = '\0';
+        rec->mLength = EgToU32(len);
+    } else {
+        this->setInlineLength(len);
+    }
+}
+
+///////////////////////////////////////////////////////////////
+
+EgString::EgString() {
+    this->setInlineLength(0);
+}
 
 EgString::EgString(size_t len) {
-    mRec = Rec::Make(nullptr, len);
+    this->initWith(nullptr, trim_size_t_to_u32(len));
 }
 
 EgString::EgString(const char str[]) {
-    size_t len = str ? strlen(str) : 0;
-    mRec = Rec::Make(str, len);
+    this->initWith(str, str ? strlen(str) : 0);
 }
 
 EgString::EgString(const char str[], size_t len) {
-    mRec = Rec::Make(str, len);
+    this->initWith(str, len);
 }
 
-EgString::EgString(const EgString& other) : mRec(other.validate().mRec) {}
+EgString::EgString(const EgString& other) {
+    memcpy(mStorage, other.validate().mStorage, sizeof(mStorage));
+    if (this->isHeap()) {
+        this->heapRec()->ref();
+    }
+}
 
-EgString::EgString(EgString&& other) noexcept : mRec(std::move(other.validate().mRec)) {
-    other.mRec = Rec::MakeEmpty();
+EgString::EgString(EgString&& other) noexcept {
+    memcpy(mStorage, other.validate().mStorage, sizeof(mStorage));
+    other.setInlineLength(0);
 }
 
 EgString::EgString(const std::string& str) {
-    mRec = Rec::Make(str.c_str(), str.size());
+    this->initWith(str.c_str(), str.size());
 }
 
 EgString::EgString(std::string_view str) {
-    mRec = Rec::Make(str.data(), str.size());
+    this->initWith(str.data(), str.size());
 }
 
 EgString::~EgString() {
     this->validate();
+    if (this->isHeap()) {
+        this->heapRec()->unref();
+    }
 }
 
 bool EgString::equals(const EgString& other) const {
-    return mRec == other.mRec || this->equals(other.c_str(), other.size());
+    if (this->isHeap() && other.isHeap() && this->heapRec() == other.heapRec()) {
+        return true;
+    }
+    return this->equals(other.c_str(), other.size());
 }
 
 bool EgString::equals(const char str[]) const {
@@ -352,67 +595,103 @@ bool EgString::equals(const char str[]) const {
 bool EgString::equals(const char str[], size_t len) const {
     EgAssert(str != nullptr || len == 0);
 
-    return mRec->mLength == len && !memcmp(mRec->data(), str, len);
+    return this->size() == len && !memcmp(this->c_str(), str, len);
 }
 
 EgString& EgString::operator=(EgString&& other) {
     this->validate();
-    if (mRec != other.mRec) {
-        this->swap(other);
+    if (this != &other) {
+        this->release();
+        memcpy(mStorage, other.mStorage, sizeof(mStorage));
+        other.setInlineLength(0);
     }
     return *this;
 }
 
 EgString& EgString::operator=(const EgString& other) {
     this->validate();
-    mRec = other.mRec;
+    if (this != &other) {
+        EgString tmp(other);
+        this->swap(tmp);
+    }
     return *this;
 }
 
 EgString& EgString::operator=(const char str[]) {
     this->validate();
-    mRec = Rec::Make(str, str ? strlen(str) : 0);
+    this->set(str);
     return *this;
 }
 
 void EgString::reset() {
     this->validate();
-    mRec = Rec::MakeEmpty();
+    this->release();
 }
 
 /**
- * @brief 获取字符串的数据
+ * @brief 获取可写的字符串数据
+ * @note 堆上的数据被共享时先复制一份（写时复制），内联数据总是独占的
  */
 char* EgString::data() {
     this->validate();
-    // 如果字符串长度为 0，则返回空指针
-    if (mRec->mLength) {
-        // 如果字符串不唯一，则复制一份数据
-        if (!mRec->unique()) {
-            mRec = Rec::Make(mRec->data(), mRec->mLength);
+    if (!this->isHeap()) {
+        return mStorage;
+    }
+    Rec* rec = this->heapRec();
+    if (!rec->unique()) {
+        EgString tmp(rec->data(), rec->mLength);
+        this->swap(tmp);
+        if (!this->isHeap()) {
+            return mStorage;
         }
     }
-    return mRec->data();
+    return this->heapRec()->data();
 }
 
 void EgString::resize(size_t len) {
     len = trim_size_t_to_u32(len);
     if (0 == len) {
         this->reset();
-    } else if (mRec->unique() && ((len >> 2) <= (mRec->mLength >> 2))) {
-        char* p = data();
-        p[len] = '\0';
-        mRec->mLength = len;
+    } else if (this->canWriteInPlace(len)) {
+        size_t oldLen = this->size();
+        char* p = this->data();
+        if (len > oldLen) {
+            memset(p + oldLen, 0, len - oldLen);
+        }
+        this->setLengthInPlace(len);
     } else {
         EgString tmp(len);
         char* dst = tmp.data();
-        int copyLen = std::min<uint32_t>(len, size());
+        size_t copyLen = std::min<size_t>(len, size());
         memcpy(dst, c_str(), copyLen);
         dst[copyLen] = '\0';
         this->swap(tmp);
     }
 }
 
+void EgString::reserve(size_t capacity) {
+    size_t length = this->size();
+    capacity = std::max<size_t>(trim_size_t_to_u32(capacity), length);
+    if (this->canWriteInPlace(capacity)) {
+        return;
+    }
+    Rec* rec = Rec::Make(this->c_str(), length, capacity);
+    this->release();
+    this->setHeapRec(rec);
+}
+
+char* EgString::growBy(size_t len) {
+    size_t length = this->size();
+    len = check_add32(length, len);
+    size_t newLength = length + len;
+    if (!this->canWriteInPlace(newLength)) {
+        this->reserve(std::max(newLength, length + (length >> 1)));
+    }
+    char* dst = this->data();
+    this->setLengthInPlace(newLength);
+    return dst + length;
+}
+
 void EgString::set(const char str[]) {
     this->set(str, str ? strlen(str) : 0);
 }
@@ -421,13 +700,12 @@ void EgString::set(const char str[], size_t len) {
     len = trim_size_t_to_u32(len);
     if (len == 0) {
         this->reset();
-    } else if (mRec->unique() && ((len >> 2) <= (mRec->mLength >> 2))) {
-        char* p = data();
+    } else if (this->canWriteInPlace(len)) {
+        char* p = this->data();
         if (str) {
-            memcpy(p, str, len);
+            memmove(p, str, len);
         }
-        p[len] = '\0';
-        mRec->mLength = len;
+        this->setLengthInPlace(len);
     } else {
         EgString tmp(str, len);
         this->swap(tmp);
@@ -458,25 +736,29 @@ void EgString::insert(size_t offset, const char str[], size_t len) {
             return;
         }
 
-        if (mRec->unique() && (length >> 2) == (length + len >> 2)) {
-            char* dst = data();
+        // str 可能指向自身的数据，此时原地 memmove 会破坏它，走复制路径
+        const char* self = this->c_str();
+        bool aliases = str >= self && str <= self + length;
+        if (!aliases && this->canWriteInPlace(length + len)) {
+            char* dst = this->data();
             if (offset < length) {
                 memmove(dst + offset + len, dst + offset, length - offset);
             }
             memcpy(dst + offset, str, len);
-            dst[length + len] = '\0';
-            mRec->mLength = EgToU32(length + len);
+            this->setLengthInPlace(length + len);
+        } else if (!aliases && offset == length) {
+            // 追加时按倍数增长，连续 append 不会每次都重新分配
+            memcpy(this->growBy(len), str, len);
         } else {
             EgString tmp(length + len);
             char* dst = tmp.data();
+            const char* src = this->c_str();
             if (offset > 0) {
-                memcpy(dst, mRec->data(), offset);
+                memcpy(dst, src, offset);
             }
             memcpy(dst + offset, str, len);
-            if (offset < mRec->mLength) {
-                memcpy(dst + offset + len,
-                        mRec->data() + offset,
-                        mRec->mLength - offset);
+            if (offset < length) {
+                memcpy(dst + offset + len, src + offset, length - offset);
             }
             swap(tmp);
         }
@@ -491,28 +773,49 @@ void EgString::insertUnichar(size_t offset, char unichar) {
     }
 }
 
+/**
+ * @brief 把 writer 写出的数字插入到 offset 处
+ *
+ * 追加到末尾时直接写进字符串自己的空间（先按最大长度增长，写完再截断），
+ * 否则先写到栈上再插入。
+ */
+template <int kMaxSize, typename Writer>
+static void insert_number(EgString* str, size_t offset, Writer&& writer) {
+    size_t length = str->size();
+    if (offset >= length) {
+        char* dst = str->growBy(kMaxSize);
+        char* end = writer(dst);
+        EgAssert(end - dst <= kMaxSize);
+        str->resize(length + (end - dst));
+        return;
+    }
+    char buffer[kMaxSize];
+    char* end = writer(buffer);
+    str->insert(offset, buffer, end - buffer);
+}
+
 void EgString::insertS32(size_t offset, int32_t value) {
-    char buffer[kEgStrAppendS32_MaxSize];
-    char* end = EgStrAppendS32(buffer, value);
-    this->insert(offset, buffer, end - buffer);
+    insert_number<kEgStrAppendS32_MaxSize>(this, offset, [value](char* dst) {
+        return EgStrAppendS32(dst, value);
+    });
 }
 
 void EgString::insertS64(size_t offset, int64_t value, int minDigits) {
-    char buffer[kEgStrAppendS64_MaxSize];
-    char* end = EgStrAppendS64(buffer, value, minDigits);
-    this->insert(offset, buffer, end - buffer);
+    insert_number<kEgStrAppendS64_MaxSize>(this, offset, [value, minDigits](char* dst) {
+        return EgStrAppendS64(dst, value, minDigits);
+    });
 }
 
 void EgString::insertU32(size_t offset, uint32_t value) {
-    char buffer[kEgStrAppendU32_MaxSize];
-    char* end = EgStrAppendU32(buffer, value);
-    this->insert(offset, buffer, end - buffer);
+    insert_number<kEgStrAppendU32_MaxSize>(this, offset, [value](char* dst) {
+        return EgStrAppendU32(dst, value);
+    });
 }
 
 void EgString::insertU64(size_t offset, uint64_t value, int minDigits) {
-    char buffer[kEgStrAppendU64_MaxSize];
-    char* end = EgStrAppendU64(buffer, value, minDigits);
-    this->insert(offset, buffer, end - buffer);
+    insert_number<kEgStrAppendU64_MaxSize>(this, offset, [value, minDigits](char* dst) {
+        return EgStrAppendU64(dst, value, minDigits);
+    });
 }
 
 void EgString::insertHex(size_t offset, uint32_t hex, int minDigits) {
@@ -522,7 +825,7 @@ void EgString::insertHex(size_t offset, uint32_t hex, int minDigits) {
     char* p = buffer + sizeof(buffer);
     do {
         *--p = EgHexadecimalDigits::gUpper[hex & 0xF];
-        hex >> 4;
+        hex >>= 4;
         minDigits--;
     } while (hex != 0);
 
@@ -534,11 +837,10 @@ void EgString::insertHex(size_t offset, uint32_t hex, int minDigits) {
     this->insert(offset, p, buffer + sizeof(buffer) - p);
 }
 
-
 void EgString::insertScalar(size_t offset, EgScalar value) {
-    char buffer[kEgStrAppendScalar_MaxSize];
-    char* end = EgStrAppendScalar(buffer, value);
-    this->insert(offset, buffer, end - buffer);
+    insert_number<kEgStrAppendScalar_MaxSize>(this, offset, [value](char* dst) {
+        return EgStrAppendScalar(dst, value);
+    });
 }
 
 void EgString::remove(size_t offset, size_t length) {
@@ -555,6 +857,16 @@ void EgString::remove(size_t offset, size_t length) {
     EgAssert(offset <= size - length);
 
     if (length > 0) {
+        size_t tail = size - offset - length;
+        if (this->canWriteInPlace(size - length)) {
+            char* dst = this->data();
+            if (tail > 0) {
+                memmove(dst + offset, dst + offset + length, tail);
+            }
+            this->setLengthInPlace(size - length);
+            return;
+        }
+
         EgString tmp(size - length);
         char* dst = tmp.data();
         const char* src = this->c_str();
@@ -563,7 +875,6 @@ void EgString::remove(size_t offset, size_t length) {
             memcpy(dst, src, offset);
         }
 
-        size_t tail = size - offset - length;
         if (tail > 0) {
             memcpy(dst + offset, src + offset + length, tail);
         }
@@ -576,7 +887,10 @@ void EgString::swap(EgString& other) {
     this->validate();
     other.validate();
 
-    std::swap(mRec, other.mRec);
+    char tmp[sizeof(mStorage)];
+    memcpy(tmp, mStorage, sizeof(mStorage));
+    memcpy(mStorage, other.mStorage, sizeof(mStorage));
+    memcpy(other.mStorage, tmp, sizeof(mStorage));
 }
 
 void EgString::printf(const char fmt[], ...) {
@@ -586,11 +900,57 @@ void EgString::printf(const char fmt[], ...) {
     va_end(args);
 }
 
+/**
+ * @brief 用格式化结果替换当前内容
+ * @note 参数可能引用本字符串的内容，所以先格式化到新字符串再交换
+ */
 void EgString::printfVAList(const char fmt[], va_list args) {
-    char stackBuffer[kBufferSize];
-    StringBuffer buffer = apply_format_string(fmt, args, stackBuffer, this);
+    EgString tmp;
+    // 格式串本身就放不进内联空间时，按格式串长度预留，多数情况下一次 vsnprintf 即可
+    size_t fmtLen = strlen(fmt);
+    if (fmtLen > kInlineCapacity) {
+        tmp.reserve(fmtLen + 64);
+    }
+    tmp.appendVAList(fmt, args);
+    this->swap(tmp);
+}
+
+void EgString::appendf(const char fmt[], ...) {
+    va_list args;
+    va_start(args, fmt);
+    this->appendVAList(fmt, args);
+    va_end(args);
+}
 
-    if (buffer.mData == stackBuffer) {
-        this->set(buffer.mData, buffer.mLength);
+void EgString::appendVAList(const char fmt[], va_list args) {
+    va_list argsCopy;
+    va_copy(argsCopy, args);
+
+    // 先写进剩余容量（末尾 '\0' 的位置也可用），放不下时只得到所需长度
+    size_t length = this->size();
+    size_t spare = this->canWriteInPlace(this->capacity()) ? this->capacity() - length : 0;
+    char* dst = spare ? this->data() + length : nullptr;
+    int outLen = std::vsnprintf(dst, spare ? spare + 1 : 0, fmt, args);
+    if (outLen <= 0) {
+        if (dst) {
+            // 恢复被覆盖的结尾
+            this->setLengthInPlace(length);
+        }
+        va_end(argsCopy);
+        return;
     }
-}
\ No newline at end of file
+
+    if ((size_t)outLen <= spare) {
+        this->setLengthInPlace(length + outLen);
+    } else {
+        if (dst) {
+            // 截断的输出可能改写了内联长度字节，先恢复再增长
+            this->setLengthInPlace(length);
+        }
+        char* tail = this->growBy(outLen);
+        // growBy 可能因长度上限截断，以实际增加的长度为准
+        size_t added = this->size() - length;
+        std::vsnprintf(tail, added + 1, fmt, argsCopy);
+    }
+    va_end(argsCopy);
+}
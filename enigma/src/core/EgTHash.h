@@ -0,0 +1,461 @@
+#pragma once
+
+#include "include/core/EgAtom.h"
+#include "include/core/EgMemory.h"
+#include "include/core/EgString.h"
+#include "include/private/base/EgAssert.h"
+#include "include/private/base/EgHash.h"
+
+#include "src/base/EgVx.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief 默认哈希，整数、指针、字符串都能用
+ *
+ * 各种字符串类型（const char*、std::string_view、std::string、EgString）按内容哈希，
+ * 结果一致，因此键为 EgString 的表可以直接用 const char* 或 string_view 查找，不必先构造键。
+ */
+struct EgGoodHash {
+    template <typename T>
+    std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>, uint64_t> operator()(T value) const {
+        return EgHash64((uint64_t)value);
+    }
+
+    template <typename T>
+    uint64_t operator()(T* ptr) const { return EgHash64((uint64_t)(uintptr_t)ptr); }
+
+    uint64_t operator()(const char* str) const { return EgHashBytes(str, strlen(str)); }
+    uint64_t operator()(std::string_view str) const { return EgHashBytes(str.data(), str.size()); }
+    uint64_t operator()(const std::string& str) const { return EgHashBytes(str.data(), str.size()); }
+    uint64_t operator()(const EgString& str) const { return EgHashBytes(str.c_str(), str.size()); }
+
+    /**
+     * @brief EgAtom 的哈希在驻留时已算好，这里只做一次混合
+     */
+    uint64_t operator()(EgAtom atom) const { return EgHash64(atom.hash()); }
+};
+
+/**
+ * @brief 默认相等比较，字符串类型之间按内容比较，其余类型用 ==
+ */
+struct EgGoodEqual {
+    template <typename A, typename B>
+    bool operator()(const A& a, const B& b) const {
+        if constexpr (IsString<A> && IsString<B>) {
+            return AsView(a) == AsView(b);
+        } else {
+            return a == b;
+        }
+    }
+
+private:
+    template <typename T>
+    static constexpr bool IsString = std::is_convertible_v<const T&, std::string_view> ||
+                                     std::is_same_v<T, EgString>;
+
+    static std::string_view AsView(std::string_view str) { return str; }
+    static std::string_view AsView(const EgString& str) { return {str.c_str(), str.size()}; }
+};
+
+/**
+ * @brief 开放寻址哈希表，EgTHashMap / EgTHashSet 的底层实现
+ *
+ * 布局参照 Swiss table：槽位之外另有一组控制字节，空槽为 kEmpty，占用的槽保存哈希的低 7 位。
+ * 查找时一次加载 16 个控制字节，用向量比较同时筛出候选槽和空槽，绝大多数查找只需一次加载、
+ * 一次键比较。探测是逐槽的线性探测（控制字节末尾镜像开头的 15 个字节，任意位置都能整组加载），
+ * 因此删除可以用反向移位（backward-shift）把后续元素前移，不留墓碑，表不会因反复增删而退化。
+ *
+ * Traits 需要提供：
+ *    static const Key& GetKey(const T&);
+ *    using Hash / Equal
+ *
+ * @note 插入和删除会移动元素，之前得到的指针随之失效
+ */
+template <typename T, typename Traits>
+class EgTHashTable {
+public:
+    EgTHashTable() = default;
+
+    EgTHashTable(const EgTHashTable& that) : EgTHashTable() {
+        this->reserve(that.fCount);
+        that.foreach([this](const T& value) { this->uncheckedInsert(T(value), Hash(Traits::GetKey(value))); });
+    }
+
+    EgTHashTable(EgTHashTable&& that) noexcept
+        : fCtrl(std::exchange(that.fCtrl, nullptr))
+        , fSlots(std::exchange(that.fSlots, nullptr))
+        , fCapacity(std::exchange(that.fCapacity, 0))
+        , fCount(std::exchange(that.fCount, 0)) {}
+
+    EgTHashTable& operator=(const EgTHashTable& that) {
+        if (this != &that) {
+            EgTHashTable copy(that);
+            this->swap(copy);
+        }
+        return *this;
+    }
+
+    EgTHashTable& operator=(EgTHashTable&& that) noexcept {
+        if (this != &that) {
+            this->reset();
+            this->swap(that);
+        }
+        return *this;
+    }
+
+    ~EgTHashTable() { this->reset(); }
+
+    void swap(EgTHashTable& that) {
+        std::swap(fCtrl, that.fCtrl);
+        std::swap(fSlots, that.fSlots);
+        std::swap(fCapacity, that.fCapacity);
+        std::swap(fCount, that.fCount);
+    }
+
+    int count() const { return (int)fCount; }
+    bool empty() const { return fCount == 0; }
+    size_t capacity() const { return fCapacity; }
+
+    /**
+     * @brief 析构所有元素并释放内存
+     */
+    void reset() {
+        if (fCtrl == nullptr) {
+            return;
+        }
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_t i = 0; i < fCapacity; ++i) {
+                if (fCtrl[i] != kEmpty) {
+                    fSlots[i].~T();
+                }
+            }
+        }
+        EgMemory::Free(gCaches_EgMemorySubsystem, fCtrl);
+        fCtrl = nullptr;
+        fSlots = nullptr;
+        fCapacity = 0;
+        fCount = 0;
+    }
+
+    /**
+     * @brief 预留空间，之后插入不超过 count 个元素不会重新分配
+     */
+    void reserve(int count) {
+        size_t capacity = kGroupWidth;
+        while (capacity * kMaxLoadNum < (size_t)count * kMaxLoadDen) {
+            capacity *= 2;
+        }
+        if (capacity > fCapacity) {
+            this->resize(capacity);
+        }
+    }
+
+    /**
+     * @brief 查找键等于 key 的元素，key 可以是与键类型不同但哈希、比较兼容的类型
+     */
+    template <typename Q>
+    T* find(const Q& key) const {
+        if (fCount == 0) {
+            return nullptr;
+        }
+        return this->findHashed(key, Hash(key));
+    }
+
+    /**
+     * @brief 插入 value，已有相同键的元素时替换它
+     * @return 表中的元素
+     */
+    T* set(T value) {
+        const uint64_t hash = Hash(Traits::GetKey(value));
+        if (fCount > 0) {
+            if (T* existing = this->findHashed(Traits::GetKey(value), hash)) {
+                *existing = std::move(value);
+                return existing;
+            }
+        }
+        if ((fCount + 1) * kMaxLoadDen > fCapacity * kMaxLoadNum) {
+            this->resize(fCapacity ? fCapacity * 2 : kGroupWidth);
+        }
+        return this->uncheckedInsert(std::move(value), hash);
+    }
+
+    /**
+     * @brief 删除键等于 key 的元素
+     * @return 是否找到并删除
+     */
+    template <typename Q>
+    bool remove(const Q& key) {
+        T* found = this->find(key);
+        if (found == nullptr) {
+            return false;
+        }
+        const size_t mask = fCapacity - 1;
+        size_t hole = (size_t)(found - fSlots);
+        fSlots[hole].~T();
+
+        // 反向移位：把空洞之后、探测链经过空洞的元素依次前移，直到遇到空槽
+        for (size_t j = (hole + 1) & mask; fCtrl[j] != kEmpty; j = (j + 1) & mask) {
+            size_t home = Home(Hash(Traits::GetKey(fSlots[j])), fCapacity);
+            // home 不在 (hole, j] 之间时，j 上的元素前移到 hole 仍然能被找到
+            if (((j - home) & mask) >= ((j - hole) & mask)) {
+                new (&fSlots[hole]) T(std::move(fSlots[j]));
+                fSlots[j].~T();
+                this->setCtrl(hole, fCtrl[j]);
+                hole = j;
+            }
+        }
+        this->setCtrl(hole, kEmpty);
+        fCount--;
+        return true;
+    }
+
+    template <typename Fn>
+    void foreach(Fn&& fn) {
+        for (size_t i = 0; i < fCapacity; ++i) {
+            if (fCtrl[i] != kEmpty) {
+                fn(fSlots[i]);
+            }
+        }
+    }
+
+    template <typename Fn>
+    void foreach(Fn&& fn) const {
+        for (size_t i = 0; i < fCapacity; ++i) {
+            if (fCtrl[i] != kEmpty) {
+                fn(static_cast<const T&>(fSlots[i]));
+            }
+        }
+    }
+
+private:
+    using Bytes16 = egvx::Vec<16, uint8_t>;
+
+    static constexpr size_t kGroupWidth = 16;
+    static constexpr uint8_t kEmpty = 0x80;
+
+    // 最大负载 3/4：线性探测下未命中的平均探测长度约 8 个槽，基本落在一组之内
+    static constexpr size_t kMaxLoadNum = 3;
+    static constexpr size_t kMaxLoadDen = 4;
+
+    static_assert(alignof(T) <= kGroupWidth, "EgTHashTable slots are aligned to 16 bytes");
+
+    template <typename Q>
+    static uint64_t Hash(const Q& key) { return typename Traits::Hash()(key); }
+
+    static uint8_t Tag(uint64_t hash) { return (uint8_t)(hash & 0x7F); }
+    static size_t Home(uint64_t hash, size_t capacity) { return (size_t)(hash >> 7) & (capacity - 1); }
+
+    /**
+     * @brief 比较结果（每字节 0 或 0xFF）压成 16 位掩码，第 k 位对应第 k 个字节
+     */
+    static uint32_t LaneMask(const Bytes16& lanes) {
+#if EGVX_USE_SIMD && defined(__SSE2__)
+        return (uint32_t)_mm_movemask_epi8(egvx::bit_pun<__m128i>(lanes));
+#else
+        uint64_t lo, hi;
+        memcpy(&lo, &lanes, 8);
+        memcpy(&hi, (const uint8_t*)&lanes + 8, 8);
+        // 第 k 个字节只保留第 k 位，乘法把 8 个字节累加到最高字节，各位互不进位
+        constexpr uint64_t kBits = 0x8040201008040201ull;
+        constexpr uint64_t kSum  = 0x0101010101010101ull;
+        return (uint32_t)(((lo & kBits) * kSum) >> 56) | ((uint32_t)(((hi & kBits) * kSum) >> 56) << 8);
+#endif
+    }
+
+    template <typename Q>
+    T* findHashed(const Q& key, uint64_t hash) const {
+        const Bytes16 h2(Tag(hash));
+        size_t i = Home(hash, fCapacity);
+        for (;;) {
+            const Bytes16 group = Bytes16::Load(fCtrl + i);
+            for (uint32_t matches = LaneMask(group == h2); matches; matches &= matches - 1) {
+                size_t slot = (i + __builtin_ctz(matches)) & (fCapacity - 1);
+                if (typename Traits::Equal()(Traits::GetKey(fSlots[slot]), key)) {
+                    return &fSlots[slot];
+                }
+            }
+            if (egvx::any(group == Bytes16(kEmpty))) {
+                return nullptr;
+            }
+            i = (i + kGroupWidth) & (fCapacity - 1);
+        }
+    }
+
+    void setCtrl(size_t i, uint8_t ctrl) {
+        fCtrl[i] = ctrl;
+        // 开头的 kGroupWidth - 1 个字节在末尾有镜像，从最后几个槽开始整组加载时能绕回开头
+        if (i < kGroupWidth - 1) {
+            fCtrl[fCapacity + i] = ctrl;
+        }
+    }
+
+    /**
+     * @brief 插入确定不存在的元素，调用者保证容量足够
+     */
+    T* uncheckedInsert(T&& value, uint64_t hash) {
+        size_t i = Home(hash, fCapacity);
+        for (;;) {
+            uint32_t empties = LaneMask(Bytes16::Load(fCtrl + i) == Bytes16(kEmpty));
+            if (empties) {
+                size_t slot = (i + __builtin_ctz(empties)) & (fCapacity - 1);
+                this->setCtrl(slot, Tag(hash));
+                fCount++;
+                return new (&fSlots[slot]) T(std::move(value));
+            }
+            i = (i + kGroupWidth) & (fCapacity - 1);
+        }
+    }
+
+    void resize(size_t capacity) {
+        EgAssert(capacity >= kGroupWidth && (capacity & (capacity - 1)) == 0);
+        uint8_t* oldCtrl = fCtrl;
+        T* oldSlots = fSlots;
+        size_t oldCapacity = fCapacity;
+
+        // 控制字节在前（capacity + 15 个，补齐到 16 的倍数），槽位紧随其后
+        size_t ctrlBytes = capacity + kGroupWidth;
+        void* memory = EgMemory::Malloc(gCaches_EgMemorySubsystem, ctrlBytes + capacity * sizeof(T));
+        if (memory == nullptr) {
+            throw std::bad_alloc();
+        }
+        fCtrl = static_cast<uint8_t*>(memory);
+        fSlots = reinterpret_cast<T*>(fCtrl + ctrlBytes);
+        fCapacity = capacity;
+        fCount = 0;
+        memset(fCtrl, kEmpty, ctrlBytes);
+
+        for (size_t i = 0; i < oldCapacity; ++i) {
+            if (oldCtrl[i] != kEmpty) {
+                this->uncheckedInsert(std::move(oldSlots[i]), Hash(Traits::GetKey(oldSlots[i])));
+                oldSlots[i].~T();
+            }
+        }
+        if (oldCtrl) {
+            EgMemory::Free(gCaches_EgMemorySubsystem, oldCtrl);
+        }
+    }
+
+    uint8_t*    fCtrl = nullptr;
+    T*          fSlots = nullptr;
+    size_t      fCapacity = 0;
+    size_t      fCount = 0;
+};
+
+/**
+ * @brief 键值对哈希表，接口与 EgTHashSet 一致
+ * 示例用法：
+ *    EgTHashMap<EgString, int> map;
+ *    map.set(EgString("uColor"), 3);
+ *    if (int* location = map.find("uColor")) { ... }
+ */
+template <typename K, typename V, typename HashT = EgGoodHash, typename EqualT = EgGoodEqual>
+class EgTHashMap {
+public:
+    struct Pair {
+        K first;
+        V second;
+    };
+
+    EgTHashMap() = default;
+
+    int count() const { return fTable.count(); }
+    bool empty() const { return fTable.empty(); }
+    void reset() { fTable.reset(); }
+    void reserve(int count) { fTable.reserve(count); }
+
+    /**
+     * @brief 设置 key 对应的值，返回表中的值
+     */
+    V* set(K key, V value) {
+        return &fTable.set(Pair{std::move(key), std::move(value)})->second;
+    }
+
+    template <typename Q>
+    V* find(const Q& key) const {
+        Pair* pair = fTable.find(key);
+        return pair ? &pair->second : nullptr;
+    }
+
+    /**
+     * @brief 返回 key 对应的值，不存在时插入默认值
+     */
+    V& operator[](const K& key) {
+        if (V* value = this->find(key)) {
+            return *value;
+        }
+        return *this->set(key, V{});
+    }
+
+    template <typename Q>
+    bool remove(const Q& key) { return fTable.remove(key); }
+
+    /**
+     * @brief 遍历所有键值对，fn(const K&, V&)
+     */
+    template <typename Fn>
+    void foreach(Fn&& fn) {
+        fTable.foreach([&fn](Pair& pair) { fn(static_cast<const K&>(pair.first), pair.second); });
+    }
+
+    template <typename Fn>
+    void foreach(Fn&& fn) const {
+        fTable.foreach([&fn](const Pair& pair) { fn(pair.first, pair.second); });
+    }
+
+private:
+    struct Traits {
+        using Hash = HashT;
+        using Equal = EqualT;
+        static const K& GetKey(const Pair& pair) { return pair.first; }
+    };
+
+    EgTHashTable<Pair, Traits> fTable;
+};
+
+/**
+ * @brief 集合，元素本身就是键
+ */
+template <typename T, typename HashT = EgGoodHash, typename EqualT = EgGoodEqual>
+class EgTHashSet {
+public:
+    EgTHashSet() = default;
+
+    int count() const { return fTable.count(); }
+    bool empty() const { return fTable.empty(); }
+    void reset() { fTable.reset(); }
+    void reserve(int count) { fTable.reserve(count); }
+
+    void add(T item) { fTable.set(std::move(item)); }
+
+    template <typename Q>
+    bool contains(const Q& item) const { return fTable.find(item) != nullptr; }
+
+    template <typename Q>
+    const T* find(const Q& item) const { return fTable.find(item); }
+
+    template <typename Q>
+    bool remove(const Q& item) { return fTable.remove(item); }
+
+    /**
+     * @brief 遍历所有元素，fn(const T&)
+     */
+    template <typename Fn>
+    void foreach(Fn&& fn) const { fTable.foreach(fn); }
+
+private:
+    struct Traits {
+        using Hash = HashT;
+        using Equal = EqualT;
+        static const T& GetKey(const T& item) { return item; }
+    };
+
+    EgTHashTable<T, Traits> fTable;
+};
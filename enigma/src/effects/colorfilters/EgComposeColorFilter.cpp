@@ -0,0 +1,38 @@
+#include "include/core/EgColorFilter.h"
+
+#include "src/core/EgColorFilterBase.h"
+
+namespace {
+
+class EgComposeColorFilter : public EgColorFilterBase {
+public:
+    EgComposeColorFilter(EgSp<EgColorFilter> outer, EgSp<EgColorFilter> inner)
+        : fOuter(std::move(outer))
+        , fInner(std::move(inner)) {}
+
+    bool affectsTransparentBlack() const override {
+        return fOuter->affectsTransparentBlack() || fInner->affectsTransparentBlack();
+    }
+
+    void appendStages(EgRasterPipeline* pipeline) const override {
+        as_CFB(fInner.get())->appendStages(pipeline);
+        as_CFB(fOuter.get())->appendStages(pipeline);
+    }
+
+private:
+    EgSp<EgColorFilter> fOuter;
+    EgSp<EgColorFilter> fInner;
+};
+
+}  // namespace
+
+EgSp<EgColorFilter> EgColorFilters::Compose(EgSp<EgColorFilter> outer,
+                                                       EgSp<EgColorFilter> inner) {
+    if (!outer) {
+        return inner;
+    }
+    if (!inner) {
+        return outer;
+    }
+    return EgMakeSp<EgComposeColorFilter>(std::move(outer), std::move(inner));
+}
@@ -0,0 +1,46 @@
+#include "include/core/EgColorFilter.h"
+
+#include "include/core/EgScalar.h"
+
+#include "src/core/EgColorFilterBase.h"
+
+#include <vector>
+
+namespace {
+
+class EgLut3DColorFilter : public EgColorFilterBase {
+public:
+    EgLut3DColorFilter(int size, const float* table)
+        : fTable(table, table + (size_t)size * size * size * 3) {
+        fCtx.table = fTable.data();
+        fCtx.size  = size;
+    }
+
+    bool affectsTransparentBlack() const override {
+        // 只改变颜色，alpha 不变，透明像素预乘后仍为透明
+        return false;
+    }
+
+    void appendStages(EgRasterPipeline* pipeline) const override {
+        pipeline->append(EgRasterPipelineOp::unpremul);
+        pipeline->append(EgRasterPipelineOp::lut_3d, &fCtx);
+        pipeline->append(EgRasterPipelineOp::clamp_01);
+        pipeline->append(EgRasterPipelineOp::premul);
+    }
+
+private:
+    std::vector<float>          fTable;
+    EgRasterPipeline_Lut3DCtx   fCtx;
+};
+
+}  // namespace
+
+EgSp<EgColorFilter> EgColorFilters::Lut3D(int size, const float* table) {
+    if (size < 2 || size > kMaxLut3DSize || table == nullptr) {
+        return nullptr;
+    }
+    if (!EgScalarsAreFinite(table, size * size * size * 3)) {
+        return nullptr;
+    }
+    return EgMakeSp<EgLut3DColorFilter>(size, table);
+}
@@ -0,0 +1,40 @@
+#include "include/core/EgColorFilter.h"
+
+#include "include/core/EgScalar.h"
+
+#include "src/core/EgColorFilterBase.h"
+
+#include <algorithm>
+
+namespace {
+
+class EgMatrixColorFilter : public EgColorFilterBase {
+public:
+    explicit EgMatrixColorFilter(const float rowMajor[20]) {
+        std::copy(rowMajor, rowMajor + 20, fCtx.m);
+    }
+
+    bool affectsTransparentBlack() const override {
+        // 透明黑反预乘后仍为 (0, 0, 0, 0)，输出 alpha 只剩平移项
+        return fCtx.m[19] > 0;
+    }
+
+    void appendStages(EgRasterPipeline* pipeline) const override {
+        pipeline->append(EgRasterPipelineOp::unpremul);
+        pipeline->append(EgRasterPipelineOp::matrix_4x5, &fCtx);
+        pipeline->append(EgRasterPipelineOp::clamp_01);
+        pipeline->append(EgRasterPipelineOp::premul);
+    }
+
+private:
+    EgRasterPipeline_MatrixCtx fCtx;
+};
+
+}  // namespace
+
+EgSp<EgColorFilter> EgColorFilters::Matrix(const float rowMajor[20]) {
+    if (!EgScalarsAreFinite(rowMajor, 20)) {
+        return nullptr;
+    }
+    return EgMakeSp<EgMatrixColorFilter>(rowMajor);
+}
@@ -0,0 +1,53 @@
+#include "include/core/EgColorFilter.h"
+
+#include "src/core/EgBlendModePriv.h"
+#include "src/core/EgColorFilterBase.h"
+
+#include <algorithm>
+
+namespace {
+
+class EgModeColorFilter : public EgColorFilterBase {
+public:
+    EgModeColorFilter(const EgColor4f& color, EgBlendMode mode) {
+        EgRGBA4f<gPremul_EgAlphaType> premul = color.premul();
+        std::copy(premul.vec(), premul.vec() + 4, fCtx.color);
+
+        EgBlendModeCoeff src, dst;
+        EgBlendMode_AsCoeff(mode, &src, &dst);
+        fCtx.srcCoeff = (int)src;
+        fCtx.dstCoeff = (int)dst;
+        fCtx.mode = (int)mode;
+    }
+
+    bool affectsTransparentBlack() const override {
+        // 目标为透明黑时结果为 color * Fs，Fs 只可能依赖 src 与 dst
+        egvx::float4 result = EgBlendMode_CoeffBlend((EgBlendModeCoeff)fCtx.srcCoeff,
+                                                     (EgBlendModeCoeff)fCtx.dstCoeff,
+                                                     egvx::float4::Load(fCtx.color),
+                                                     egvx::float4(0.0f));
+        return egvx::any(result != 0.0f);
+    }
+
+    void appendStages(EgRasterPipeline* pipeline) const override {
+        pipeline->append(EgRasterPipelineOp::blend_color, &fCtx);
+    }
+
+private:
+    EgRasterPipeline_BlendColorCtx fCtx;
+};
+
+}  // namespace
+
+EgSp<EgColorFilter> EgColorFilters::Blend(const EgColor4f& color, EgBlendMode mode) {
+    if (!EgBlendMode_AsCoeff(mode, nullptr, nullptr)) {
+        return nullptr;
+    }
+    EgColor4f pinned = {
+        std::min(std::max(color.fR, 0.0f), 1.0f),
+        std::min(std::max(color.fG, 0.0f), 1.0f),
+        std::min(std::max(color.fB, 0.0f), 1.0f),
+        std::min(std::max(color.fA, 0.0f), 1.0f),
+    };
+    return EgMakeSp<EgModeColorFilter>(pinned, mode);
+}
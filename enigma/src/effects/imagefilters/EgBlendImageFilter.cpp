@@ -0,0 +1,70 @@
+#include "include/effects/EgImageFilters.h"
+
+#include "src/core/EgBlendModePriv.h"
+#include "src/core/EgFrameStatsPriv.h"
+#include "src/core/EgImageFilterBase.h"
+
+namespace {
+
+class EgBlendImageFilter : public EgImageFilterBase {
+public:
+    EgBlendImageFilter(EgBlendMode mode,
+                       EgSp<EgImageFilter> background,
+                       EgSp<EgImageFilter> foreground)
+        : EgImageFilterBase({std::move(background), std::move(foreground)})
+        , fMode(mode) {
+        EgBlendMode_AsCoeff(mode, &fSrcCoeff, &fDstCoeff);
+    }
+
+protected:
+    EgSp<EgSpecialImage> onFilterImage(const EgImageFilterContext& ctx) const override {
+        EgSp<EgSpecialImage> background = this->filterInput(0, ctx);
+        EgSp<EgSpecialImage> foreground = this->filterInput(1, ctx);
+
+        // 系数混合模式下两个透明像素的混合结果仍为透明，只需计算两者的并集
+        EgIRect bounds = EgIRect::MakeEmpty();
+        if (background) {
+            bounds.join(background->bounds());
+        }
+        if (foreground) {
+            bounds.join(foreground->bounds());
+        }
+        if (!bounds.intersect(ctx.desiredOutput())) {
+            return nullptr;
+        }
+
+        EgSp<EgSpecialImage> result = EgSpecialImage::Make(bounds);
+        if (!result) {
+            return nullptr;
+        }
+        const int width = bounds.width();
+        std::vector<egvx::float4> dst(width);
+        std::vector<egvx::float4> src(width);
+        for (int y = bounds.fTop; y < bounds.fBottom; ++y) {
+            EgLoadPremulRow(background.get(), bounds.fLeft, y, width, dst.data());
+            EgLoadPremulRow(foreground.get(), bounds.fLeft, y, width, src.data());
+            uint8_t* pixel = result->getAddr(bounds.fLeft, y);
+            for (int x = 0; x < width; ++x, pixel += 4) {
+                EgStorePremul(EgBlendMode_CoeffBlend(fSrcCoeff, fDstCoeff, src[x], dst[x]), pixel);
+            }
+        }
+        EgFrameStats_AddPixelsBlended(fMode, (uint64_t)width * bounds.height());
+        return result;
+    }
+
+private:
+    EgBlendMode      fMode;
+    EgBlendModeCoeff fSrcCoeff;
+    EgBlendModeCoeff fDstCoeff;
+};
+
+}  // namespace
+
+EgSp<EgImageFilter> EgImageFilters::Blend(EgBlendMode mode,
+                                                     EgSp<EgImageFilter> background,
+                                                     EgSp<EgImageFilter> foreground) {
+    if (!EgBlendMode_AsCoeff(mode, nullptr, nullptr)) {
+        return nullptr;
+    }
+    return EgMakeSp<EgBlendImageFilter>(mode, std::move(background), std::move(foreground));
+}
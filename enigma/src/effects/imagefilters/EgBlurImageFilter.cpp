@@ -0,0 +1,51 @@
+#include "include/effects/EgImageFilters.h"
+
+#include "src/core/EgBlurEngine.h"
+#include "src/core/EgImageFilterBase.h"
+
+namespace {
+
+class EgBlurImageFilter : public EgImageFilterBase {
+public:
+    EgBlurImageFilter(EgScalar sigmaX, EgScalar sigmaY, EgSp<EgImageFilter> input)
+        : EgImageFilterBase({std::move(input)})
+        , fSigmaX(sigmaX)
+        , fSigmaY(sigmaY)
+        , fRadiusX(EgBlurEngine::ComputeRadius(sigmaX))
+        , fRadiusY(EgBlurEngine::ComputeRadius(sigmaY)) {}
+
+    EgIRect onFilterNodeBounds(const EgIRect& src, MapDirection direction) const override {
+        // 模糊是对称的：输出外扩半径，反向所需的输入同样外扩半径
+        return src.makeOutset(fRadiusX, fRadiusY);
+    }
+
+protected:
+    EgSp<EgSpecialImage> onFilterImage(const EgImageFilterContext& ctx) const override {
+        EgSp<EgSpecialImage> input = this->filterInput(0, ctx);
+        if (!input) {
+            return nullptr;
+        }
+        EgMask blurred;
+        if (!EgBlurEngine::Blur(input->asMask(), fSigmaX, fSigmaY, &blurred)) {
+            return nullptr;
+        }
+        EgSp<EgSpecialImage> result = EgSpecialImage::Adopt(&blurred);
+        return result ? result->makeSubset(ctx.desiredOutput()) : nullptr;
+    }
+
+private:
+    const EgScalar  fSigmaX;
+    const EgScalar  fSigmaY;
+    const int       fRadiusX;
+    const int       fRadiusY;
+};
+
+}  // namespace
+
+EgSp<EgImageFilter> EgImageFilters::Blur(EgScalar sigmaX, EgScalar sigmaY,
+                                                    EgSp<EgImageFilter> input) {
+    if (!EgScalarIsFinite(sigmaX) || !EgScalarIsFinite(sigmaY) || sigmaX < 0 || sigmaY < 0) {
+        return nullptr;
+    }
+    return EgMakeSp<EgBlurImageFilter>(sigmaX, sigmaY, std::move(input));
+}
@@ -0,0 +1,81 @@
+#include "include/effects/EgImageFilters.h"
+
+#include "src/core/EgColorFilterBase.h"
+#include "src/core/EgImageFilterBase.h"
+#include "src/core/EgRasterPipeline.h"
+
+#include <cstring>
+
+namespace {
+
+class EgColorFilterImageFilter : public EgImageFilterBase {
+public:
+    EgColorFilterImageFilter(EgSp<EgColorFilter> cf, EgSp<EgImageFilter> input)
+        : EgImageFilterBase({std::move(input)})
+        , fColorFilter(std::move(cf)) {}
+
+    EgIRect onFilterNodeBounds(const EgIRect& src, MapDirection direction) const override {
+        if (direction == gForward_MapDirection && fColorFilter->affectsTransparentBlack()) {
+            return Unbounded();
+        }
+        return src;
+    }
+
+    bool isColorFilterNode(EgSp<EgColorFilter>* filter) const override {
+        *filter = fColorFilter;
+        return true;
+    }
+
+protected:
+    EgSp<EgSpecialImage> onFilterImage(const EgImageFilterContext& ctx) const override {
+        EgSp<EgSpecialImage> input = this->filterInput(0, ctx);
+
+        EgIRect bounds = ctx.desiredOutput();
+        if (!fColorFilter->affectsTransparentBlack()) {
+            if (!input || !bounds.intersect(input->bounds())) {
+                return nullptr;
+            }
+        }
+
+        EgSp<EgSpecialImage> result = EgSpecialImage::Make(bounds);
+        if (!result) {
+            return nullptr;
+        }
+        EgIRect copy;
+        if (input && copy.intersect(input->bounds(), bounds)) {
+            for (int y = copy.fTop; y < copy.fBottom; ++y) {
+                memcpy(result->getAddr(copy.fLeft, y), input->getAddr(copy.fLeft, y), (size_t)copy.width() * 4);
+            }
+        }
+
+        // 在结果上原地执行 load -> 颜色滤镜的各阶段 -> store，每个像素只读写一次
+        EgRasterPipeline_MemoryCtx memory = {result->getAddr(bounds.fLeft, bounds.fTop),
+                                             (int)(result->rowBytes() / 4)};
+        EgSTArenaAlloc<256> alloc;
+        EgRasterPipeline pipeline(&alloc);
+        pipeline.append(EgRasterPipelineOp::load_8888, &memory);
+        as_CFB(fColorFilter.get())->appendStages(&pipeline);
+        pipeline.append(EgRasterPipelineOp::store_8888, &memory);
+        pipeline.run(0, 0, bounds.width(), bounds.height());
+        return result;
+    }
+
+private:
+    EgSp<EgColorFilter> fColorFilter;
+};
+
+}  // namespace
+
+EgSp<EgImageFilter> EgImageFilters::ColorFilter(EgSp<EgColorFilter> cf,
+                                                           EgSp<EgImageFilter> input) {
+    if (!cf) {
+        return input;
+    }
+    // 连续的颜色滤镜节点合并为一个，多个滤镜在同一趟流水线中完成
+    EgSp<EgColorFilter> inputCF;
+    if (input && as_IFB(input.get())->isColorFilterNode(&inputCF)) {
+        return EgMakeSp<EgColorFilterImageFilter>(
+                EgColorFilters::Compose(std::move(cf), std::move(inputCF)), input->refInput(0));
+    }
+    return EgMakeSp<EgColorFilterImageFilter>(std::move(cf), std::move(input));
+}
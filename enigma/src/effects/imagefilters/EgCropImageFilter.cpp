@@ -0,0 +1,38 @@
+#include "include/effects/EgImageFilters.h"
+
+#include "src/core/EgImageFilterBase.h"
+
+namespace {
+
+class EgCropImageFilter : public EgImageFilterBase {
+public:
+    EgCropImageFilter(const EgIRect& rect, EgSp<EgImageFilter> input)
+        : EgImageFilterBase({std::move(input)})
+        , fRect(rect) {}
+
+    EgIRect onFilterNodeBounds(const EgIRect& src, MapDirection direction) const override {
+        // 两个方向都只与裁剪矩形求交：裁剪矩形之外的输入像素对输出没有影响
+        EgIRect bounds;
+        return bounds.intersect(src, fRect) ? bounds : EgIRect::MakeEmpty();
+    }
+
+protected:
+    EgSp<EgSpecialImage> onFilterImage(const EgImageFilterContext& ctx) const override {
+        EgSp<EgSpecialImage> input = this->filterInput(0, ctx);
+        return input ? input->makeSubset(fRect) : nullptr;
+    }
+
+private:
+    const EgIRect fRect;
+};
+
+}  // namespace
+
+EgSp<EgImageFilter> EgImageFilters::Crop(const EgRect& rect, EgSp<EgImageFilter> input) {
+    if (!rect.isFinite()) {
+        return nullptr;
+    }
+    EgIRect irect;
+    rect.round(&irect);
+    return EgMakeSp<EgCropImageFilter>(irect.makeSorted(), std::move(input));
+}
@@ -0,0 +1,62 @@
+#include "include/effects/EgImageFilters.h"
+
+#include "src/core/EgBlendModePriv.h"
+#include "src/core/EgImageFilterBase.h"
+
+namespace {
+
+class EgMergeImageFilter : public EgImageFilterBase {
+public:
+    explicit EgMergeImageFilter(std::vector<EgSp<EgImageFilter>> inputs)
+        : EgImageFilterBase(std::move(inputs)) {}
+
+protected:
+    EgSp<EgSpecialImage> onFilterImage(const EgImageFilterContext& ctx) const override {
+        std::vector<EgSp<EgSpecialImage>> images;
+        EgIRect bounds = EgIRect::MakeEmpty();
+        for (int i = 0; i < this->countInputs(); ++i) {
+            EgSp<EgSpecialImage> image = this->filterInput(i, ctx);
+            if (image) {
+                bounds.join(image->bounds());
+                images.push_back(std::move(image));
+            }
+        }
+        if (images.size() == 1) {
+            return images[0];
+        }
+        if (!bounds.intersect(ctx.desiredOutput())) {
+            return nullptr;
+        }
+
+        EgSp<EgSpecialImage> result = EgSpecialImage::Make(bounds);
+        if (!result) {
+            return nullptr;
+        }
+        const int width = bounds.width();
+        std::vector<egvx::float4> dst(width);
+        std::vector<egvx::float4> src(width);
+        for (int y = bounds.fTop; y < bounds.fBottom; ++y) {
+            EgLoadPremulRow(images[0].get(), bounds.fLeft, y, width, dst.data());
+            for (size_t i = 1; i < images.size(); ++i) {
+                EgLoadPremulRow(images[i].get(), bounds.fLeft, y, width, src.data());
+                for (int x = 0; x < width; ++x) {
+                    dst[x] = EgBlendMode_CoeffBlend(EgBlendModeCoeff::gOne, EgBlendModeCoeff::gISA, src[x], dst[x]);
+                }
+            }
+            uint8_t* pixel = result->getAddr(bounds.fLeft, y);
+            for (int x = 0; x < width; ++x, pixel += 4) {
+                EgStorePremul(dst[x], pixel);
+            }
+        }
+        return result;
+    }
+};
+
+}  // namespace
+
+EgSp<EgImageFilter> EgImageFilters::Merge(std::vector<EgSp<EgImageFilter>> inputs) {
+    if (inputs.empty()) {
+        return nullptr;
+    }
+    return EgMakeSp<EgMergeImageFilter>(std::move(inputs));
+}
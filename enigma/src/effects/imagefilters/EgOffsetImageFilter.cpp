@@ -0,0 +1,35 @@
+#include "include/effects/EgImageFilters.h"
+
+#include "src/core/EgImageFilterBase.h"
+
+namespace {
+
+class EgOffsetImageFilter : public EgImageFilterBase {
+public:
+    EgOffsetImageFilter(int dx, int dy, EgSp<EgImageFilter> input)
+        : EgImageFilterBase({std::move(input)})
+        , fDx(dx)
+        , fDy(dy) {}
+
+    EgIRect onFilterNodeBounds(const EgIRect& src, MapDirection direction) const override {
+        return direction == gForward_MapDirection ? src.makeOffsets(fDx, fDy)
+                                                  : src.makeOffsets(-fDx, -fDy);
+    }
+
+protected:
+    EgSp<EgSpecialImage> onFilterImage(const EgImageFilterContext& ctx) const override {
+        // 平移只改变图像的位置，不拷贝像素
+        EgSp<EgSpecialImage> input = this->filterInput(0, ctx);
+        return input ? input->makeOffset(fDx, fDy) : nullptr;
+    }
+
+private:
+    const int fDx;
+    const int fDy;
+};
+
+}  // namespace
+
+EgSp<EgImageFilter> EgImageFilters::Offset(int dx, int dy, EgSp<EgImageFilter> input) {
+    return EgMakeSp<EgOffsetImageFilter>(dx, dy, std::move(input));
+}
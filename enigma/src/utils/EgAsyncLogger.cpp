@@ -0,0 +1,345 @@
+#include "src/utils/EgAsyncLogger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace {
+
+/**
+ * @brief 进程内从 0 开始编号的线程 ID，每个线程只分配一次，无锁
+ */
+static int current_tid() {
+    static std::atomic<int> gNextTid {0};
+    thread_local const int tid = gNextTid.fetch_add(1, std::memory_order_relaxed);
+    return tid;
+}
+
+static uint64_t now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static constexpr uint32_t align_record(uint32_t size) {
+    return (size + sizeof(EgLogRing::Record) - 1) & ~(uint32_t)(sizeof(EgLogRing::Record) - 1);
+}
+
+/**
+ * @brief 线程退出时把缓冲区标记为退役，由写线程取完剩余日志后释放
+ */
+struct ThreadRingHolder {
+    std::shared_ptr<EgLogRing> fRing;
+
+    ~ThreadRingHolder() {
+        if (fRing) {
+            fRing->retire();
+        }
+    }
+};
+
+}  // namespace
+
+EgLogRing::EgLogRing(int tid, const char* threadName)
+    : fBuffer(static_cast<uint8_t*>(aligned_alloc(64, kCapacity)))
+    , fTid(tid) {
+    strncpy(fThreadName, threadName, sizeof(fThreadName) - 1);
+    fThreadName[sizeof(fThreadName) - 1] = '\0';
+}
+
+void EgLogRing::copyThreadName(char name[kThreadNameLength]) const {
+    std::lock_guard<std::mutex> lock(fNameMutex);
+    memcpy(name, fThreadName, sizeof(fThreadName));
+}
+
+void EgLogRing::setThreadName(const char* name) {
+    std::lock_guard<std::mutex> lock(fNameMutex);
+    strncpy(fThreadName, name, sizeof(fThreadName) - 1);
+    fThreadName[sizeof(fThreadName) - 1] = '\0';
+    fNameChanged.store(true, std::memory_order_relaxed);
+}
+
+EgLogRing::~EgLogRing() {
+    free(fBuffer);
+}
+
+bool EgLogRing::tryPush(EgLogLevel level, const char* tag, uint32_t formatId, uint64_t timeNs,
+                        const char* message, uint32_t length) {
+    length = std::min(length, kMaxMessageLength);
+    const uint32_t size = align_record(sizeof(Record) + length);
+
+    uint64_t head = fHead.load(std::memory_order_relaxed);
+    const uint64_t tail = fTail.load(std::memory_order_acquire);
+    const uint32_t offset = (uint32_t)(head & (kCapacity - 1));
+    const uint32_t contiguous = kCapacity - offset;
+
+    // 尾部连续空间放不下时，用一条填充记录占满尾部再从头写
+    const uint32_t padding = contiguous < size ? contiguous : 0;
+    if (head + padding + size - tail > kCapacity) {
+        fDropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    if (padding) {
+        Record* pad = reinterpret_cast<Record*>(fBuffer + offset);
+        pad->fSize = padding;
+        pad->fPadding = true;
+        head += padding;
+    }
+
+    Record* record = reinterpret_cast<Record*>(fBuffer + (head & (kCapacity - 1)));
+    record->fSize    = size;
+    record->fLength  = length;
+    record->fTimeNs  = timeNs;
+    record->fTag     = tag;
+    record->fLevel   = level;
+    record->fPadding = false;
+    record->fFormatId = formatId;
+    memcpy(record + 1, message, length);
+
+    fHead.store(head + size, std::memory_order_release);
+    return true;
+}
+
+////////////////////////////////////////////////////////
+
+EgAsyncLogger& EgAsyncLogger::Get() {
+    // 有意泄漏：其他线程可能在静态析构之后仍在写日志
+    static EgAsyncLogger* gLogger = [] {
+        EgAsyncLogger* logger = new EgAsyncLogger();
+        std::atexit([] { EgAsyncLogger::Get().shutdown(); });
+        return logger;
+    }();
+    return *gLogger;
+}
+
+EgAsyncLogger::EgAsyncLogger()
+    : fOutputFd(STDOUT_FILENO) {
+    fOutput.reserve(64 * 1024);
+    fThread = std::thread([this] { this->threadMain(); });
+}
+
+EgLogRing* EgAsyncLogger::threadRing() {
+    thread_local ThreadRingHolder holder;
+    if (!holder.fRing) {
+        char name[EgLogRing::kThreadNameLength] = {};
+        pthread_getname_np(pthread_self(), name, sizeof(name));
+        holder.fRing = std::make_shared<EgLogRing>(current_tid(), name);
+        std::lock_guard<std::mutex> lock(fRingsMutex);
+        fRings.push_back(holder.fRing);
+    }
+    return holder.fRing.get();
+}
+
+void EgAsyncLogger::setThreadName(const char* name) {
+    pthread_setname_np(pthread_self(), name);
+    this->threadRing()->setThreadName(name);
+}
+
+void EgAsyncLogger::write(EgLogLevel level, const char* tag, const char* message, size_t length) {
+    if (!fRunning.load(std::memory_order_acquire)) {
+        // 写线程已结束（进程退出阶段），退化为同步写出
+        std::lock_guard<std::mutex> lock(fDrainMutex);
+        fOutput.clear();
+        fOutput.append(message, length);
+        fOutput.push_back('\n');
+        this->writeOut(fOutputFd.load(std::memory_order_relaxed), fOutput.data(), fOutput.size());
+        return;
+    }
+
+    EgLogRing* ring = this->threadRing();
+    ring->tryPush(level, tag, 0, now_ns(), message, (uint32_t)std::min<size_t>(length, UINT32_MAX));
+    if (ring->isHalfFull() && !fWakeRequested.exchange(true, std::memory_order_relaxed)) {
+        fWakeCond.notify_one();
+    }
+}
+
+void EgAsyncLogger::writeBinary(const EgLogFormatSite& site, const uint8_t* args, size_t length) {
+    if (!fRunning.load(std::memory_order_acquire)) {
+        std::string message;
+        EgLogFormatArgs(site.fFormat, args, length, &message);
+        this->write(site.fLevel, site.fTag, message.data(), message.size());
+        return;
+    }
+
+    EgLogRing* ring = this->threadRing();
+    ring->tryPush(site.fLevel, site.fTag, site.fId, now_ns(), reinterpret_cast<const char*>(args),
+                  (uint32_t)std::min<size_t>(length, EgLogRing::kMaxMessageLength));
+    if (ring->isHalfFull() && !fWakeRequested.exchange(true, std::memory_order_relaxed)) {
+        fWakeCond.notify_one();
+    }
+}
+
+uint32_t EgAsyncLogger::registerSite(const EgLogFormatSite* site) {
+    std::lock_guard<std::mutex> lock(fSitesMutex);
+    fSites.push_back(site);
+    return (uint32_t)fSites.size();
+}
+
+void EgAsyncLogger::setBinaryOutputFd(int fd) {
+    std::lock_guard<std::mutex> lock(fDrainMutex);
+    // 先按原来的模式写出已提交的日志
+    this->drainLocked();
+    fBinaryFd = fd;
+    if (fd >= 0) {
+        // 新文件需要重新写出调用点和线程信息
+        ++fBinaryEpoch;
+        fSitesWritten = 0;
+        this->writeOut(fd, EgBinaryLog::kMagic, sizeof(EgBinaryLog::kMagic));
+    }
+}
+
+void EgAsyncLogger::flush() {
+    std::lock_guard<std::mutex> lock(fDrainMutex);
+    this->drainLocked();
+}
+
+void EgAsyncLogger::shutdown() {
+    if (!fRunning.exchange(false)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(fWakeMutex);
+        fWakeRequested.store(true, std::memory_order_relaxed);
+    }
+    fWakeCond.notify_one();
+    if (fThread.joinable()) {
+        fThread.join();
+    }
+    this->flush();
+}
+
+void EgAsyncLogger::threadMain() {
+    pthread_setname_np(pthread_self(), "EgLogWriter");
+    while (fRunning.load(std::memory_order_acquire)) {
+        {
+            std::unique_lock<std::mutex> lock(fWakeMutex);
+            fWakeCond.wait_for(lock, std::chrono::milliseconds(kFlushIntervalMs), [this] {
+                return fWakeRequested.load(std::memory_order_relaxed);
+            });
+            fWakeRequested.store(false, std::memory_order_relaxed);
+        }
+        this->flush();
+    }
+}
+
+void EgAsyncLogger::drainLocked() {
+    std::vector<std::shared_ptr<EgLogRing>> rings;
+    {
+        std::lock_guard<std::mutex> lock(fRingsMutex);
+        rings = fRings;
+    }
+
+    struct Pending {
+        const EgLogRing::Record*    fRecord;
+        size_t                      fRing;
+    };
+    struct ThreadInfo {
+        uint32_t    fTid;
+        char        fName[EgLogRing::kThreadNameLength];
+    };
+    std::vector<Pending> pending;
+    std::vector<uint64_t> ends(rings.size());
+    std::vector<ThreadInfo> threads(rings.size());
+    for (size_t i = 0; i < rings.size(); ++i) {
+        threads[i].fTid = (uint32_t)rings[i]->tid();
+        rings[i]->copyThreadName(threads[i].fName);
+        ends[i] = rings[i]->peek([&](const EgLogRing::Record& record) {
+            pending.push_back({&record, i});
+        });
+    }
+
+    // 各线程的缓冲区内部已按时间有序，合并后整体按时间排序
+    std::stable_sort(pending.begin(), pending.end(), [](const Pending& a, const Pending& b) {
+        return a.fRecord->fTimeNs < b.fRecord->fTimeNs;
+    });
+
+    fOutput.clear();
+    char dropped[128];
+    if (fBinaryFd >= 0) {
+        {
+            // 调用点在引用它的记录被提交之前就已登记，因此这里总能覆盖本批记录用到的全部 ID
+            std::lock_guard<std::mutex> lock(fSitesMutex);
+            for (; fSitesWritten < fSites.size(); ++fSitesWritten) {
+                EgBinaryLog::AppendSite(&fOutput, *fSites[fSitesWritten]);
+            }
+        }
+        for (size_t i = 0; i < rings.size(); ++i) {
+            const bool renamed = rings[i]->takeNameChanged();
+            if (renamed || rings[i]->binaryEpoch() != fBinaryEpoch) {
+                EgBinaryLog::AppendThread(&fOutput, threads[i].fTid, threads[i].fName);
+                rings[i]->setBinaryEpoch(fBinaryEpoch);
+            }
+        }
+        for (const Pending& p : pending) {
+            const EgLogRing::Record& record = *p.fRecord;
+            if (record.fFormatId) {
+                EgBinaryLog::AppendEvent(&fOutput, record.fFormatId, threads[p.fRing].fTid,
+                                         record.fTimeNs, record.text(), record.fLength);
+            } else {
+                EgBinaryLog::AppendText(&fOutput, record.fLevel, threads[p.fRing].fTid,
+                                        record.fTimeNs, record.fTag, record.text(), record.fLength);
+            }
+        }
+    } else {
+        std::vector<const EgLogFormatSite*> sites;
+        for (const Pending& p : pending) {
+            const EgLogRing::Record& record = *p.fRecord;
+            EgLogFormatPrefix(&fTimeFormatter, record.fTimeNs, threads[p.fRing].fName,
+                              record.fLevel, record.fTag, &fOutput);
+            if (record.fFormatId) {
+                if (sites.size() < record.fFormatId) {
+                    std::lock_guard<std::mutex> lock(fSitesMutex);
+                    sites = fSites;
+                }
+                EgLogFormatArgs(sites[record.fFormatId - 1]->fFormat,
+                                reinterpret_cast<const uint8_t*>(record.text()), record.fLength, &fOutput);
+            } else {
+                fOutput.append(record.text(), record.fLength);
+            }
+            fOutput.push_back('\n');
+        }
+    }
+    for (size_t i = 0; i < rings.size(); ++i) {
+        if (uint64_t count = rings[i]->takeDropped()) {
+            int length = snprintf(dropped, sizeof(dropped), "[EgLog] %s dropped %llu messages",
+                                  threads[i].fName, (unsigned long long)count);
+            length = std::min(length, (int)sizeof(dropped) - 1);
+            if (fBinaryFd >= 0) {
+                EgBinaryLog::AppendText(&fOutput, gWarn_EgLogLevel, threads[i].fTid,
+                                        now_ns(), "EgLog", dropped, (uint32_t)length);
+            } else {
+                fOutput.append(dropped, (size_t)length);
+                fOutput.push_back('\n');
+            }
+        }
+        rings[i]->release(ends[i]);
+    }
+    this->writeOut(fBinaryFd >= 0 ? fBinaryFd : fOutputFd.load(std::memory_order_relaxed),
+                   fOutput.data(), fOutput.size());
+
+    // 释放已退役且取空的缓冲区；retire 在最后一次写入之后，因此取空后不会再有新记录
+    std::lock_guard<std::mutex> lock(fRingsMutex);
+    fRings.erase(std::remove_if(fRings.begin(), fRings.end(), [](const std::shared_ptr<EgLogRing>& ring) {
+        return ring->isRetired() && ring->empty();
+    }), fRings.end());
+}
+
+void EgAsyncLogger::writeOut(int fd, const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t written = ::write(fd, data, length);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        data += written;
+        length -= (size_t)written;
+    }
+}
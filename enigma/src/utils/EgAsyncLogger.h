@@ -0,0 +1,199 @@
+#pragma once
+
+#include "include/utils/EgLog.h"
+
+#include "src/utils/EgLogFormat.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 单生产者单消费者的字节环形缓冲区，每个写日志的线程独占一个
+ *
+ * 生产者（写日志的线程）只推进 fHead，消费者（写线程）只推进 fTail，两者都无锁。
+ * 记录是变长的，按记录头大小（32 字节）对齐，因此尾部剩余空间总能放下一个记录头；
+ * 放不下整条记录时写入一条填充记录并回绕到开头。
+ */
+class EgLogRing {
+public:
+    struct Record {
+        uint32_t        fSize;      // 整条记录的字节数，含记录头，按 sizeof(Record) 对齐
+        uint32_t        fLength;    // 消息文本的字节数
+        uint64_t        fTimeNs;    // CLOCK_REALTIME，纳秒
+        const char*     fTag;
+        EgLogLevel      fLevel;
+        bool            fPadding;
+        uint32_t        fFormatId;  // 0 为文本消息，否则为 EgLogFormatSite::fId，消息体是 EgLogArgs 编码的参数
+
+        const char* text() const { return reinterpret_cast<const char*>(this + 1); }
+    };
+
+    static_assert(sizeof(Record) == 32, "record alignment relies on a 32-byte header");
+
+    static constexpr uint32_t kCapacity = 64 * 1024;
+    static constexpr uint32_t kMaxMessageLength = 4 * 1024;
+    static constexpr size_t kThreadNameLength = 16;    // 与 pthread 线程名长度上限一致
+
+    EgLogRing(int tid, const char* threadName);
+    ~EgLogRing();
+
+    EgLogRing(const EgLogRing&) = delete;
+    EgLogRing& operator=(const EgLogRing&) = delete;
+
+    /**
+     * @brief 生产者调用，空间不足时返回 false 并计入丢弃数
+     */
+    bool tryPush(EgLogLevel level, const char* tag, uint32_t formatId, uint64_t timeNs,
+                 const char* message, uint32_t length);
+
+    /**
+     * @brief 消费者调用：遍历 [fTail, head) 中的记录，不移动 fTail
+     * @return 本次遍历到的末尾位置，处理完后传给 release
+     */
+    template <typename Fn>
+    uint64_t peek(Fn&& fn) const {
+        uint64_t tail = fTail.load(std::memory_order_relaxed);
+        const uint64_t head = fHead.load(std::memory_order_acquire);
+        while (tail < head) {
+            const Record* record = reinterpret_cast<const Record*>(fBuffer + (tail & (kCapacity - 1)));
+            if (!record->fPadding) {
+                fn(*record);
+            }
+            tail += record->fSize;
+        }
+        return tail;
+    }
+
+    void release(uint64_t position) { fTail.store(position, std::memory_order_release); }
+
+    /**
+     * @brief 已用字节数超过一半时返回 true，用于提前唤醒写线程
+     */
+    bool isHalfFull() const {
+        return fHead.load(std::memory_order_relaxed) - fTail.load(std::memory_order_relaxed) > kCapacity / 2;
+    }
+
+    bool empty() const {
+        return fHead.load(std::memory_order_acquire) == fTail.load(std::memory_order_relaxed);
+    }
+
+    uint64_t takeDropped() { return fDropped.exchange(0, std::memory_order_relaxed); }
+
+    int tid() const { return fTid; }
+
+    /**
+     * @brief 线程名在创建时取一次并缓存，改名走 setThreadName，不在每条日志上调用 pthread_getname_np
+     */
+    void copyThreadName(char name[kThreadNameLength]) const;
+    void setThreadName(const char* name);
+
+    /**
+     * @brief 自上次调用以来线程名是否改变过，只由消费者调用
+     */
+    bool takeNameChanged() { return fNameChanged.exchange(false, std::memory_order_relaxed); }
+
+    /**
+     * @brief 所属线程已退出，写线程取完剩余记录后即可释放
+     */
+    void retire() { fRetired.store(true, std::memory_order_release); }
+    bool isRetired() const { return fRetired.load(std::memory_order_acquire); }
+
+    /**
+     * @brief 二进制输出中线程信息记录是否已写出，只由消费者访问
+     */
+    uint32_t binaryEpoch() const { return fBinaryEpoch; }
+    void setBinaryEpoch(uint32_t epoch) { fBinaryEpoch = epoch; }
+
+private:
+    uint8_t*                fBuffer;
+    int                     fTid;
+    mutable std::mutex      fNameMutex;
+    char                    fThreadName[kThreadNameLength];
+    std::atomic<bool>       fNameChanged {false};
+    uint32_t                fBinaryEpoch = 0;
+    std::atomic<bool>       fRetired {false};
+    std::atomic<uint64_t>   fDropped {0};
+
+    alignas(64) std::atomic<uint64_t> fHead {0};
+    alignas(64) std::atomic<uint64_t> fTail {0};
+};
+
+/**
+ * @brief 后台写线程
+ *
+ * 每隔 kFlushIntervalMs 或有缓冲区过半时醒来，从所有线程的缓冲区中取出记录，
+ * 按时间排序后格式化进一块输出缓冲，再用一次 write 写出。
+ * 二进制模式下不做格式化，记录按 EgBinaryLog 格式原样写出。
+ */
+class EgAsyncLogger {
+public:
+    static constexpr int kFlushIntervalMs = 10;
+
+    static EgAsyncLogger& Get();
+
+    /**
+     * @brief 当前线程的环形缓冲区，首次调用时创建并注册
+     */
+    EgLogRing* threadRing();
+
+    void setThreadName(const char* name);
+
+    void write(EgLogLevel level, const char* tag, const char* message, size_t length);
+
+    void writeBinary(const EgLogFormatSite& site, const uint8_t* args, size_t length);
+
+    /**
+     * @brief 登记一个二进制日志调用点，返回从 1 开始的 ID
+     */
+    uint32_t registerSite(const EgLogFormatSite* site);
+
+    void flush();
+
+    void setOutputFd(int fd) { fOutputFd.store(fd, std::memory_order_relaxed); }
+
+    void setBinaryOutputFd(int fd);
+
+    /**
+     * @brief 写出剩余日志并结束写线程，之后的日志同步写出
+     */
+    void shutdown();
+
+private:
+    EgAsyncLogger();
+
+    void threadMain();
+
+    /**
+     * @brief 取出所有缓冲区中的记录并写出，调用者需持有 fDrainMutex
+     */
+    void drainLocked();
+
+    void writeOut(int fd, const char* data, size_t length);
+
+    std::mutex                                  fRingsMutex;
+    std::vector<std::shared_ptr<EgLogRing>>     fRings;
+
+    std::mutex                                  fSitesMutex;
+    std::vector<const EgLogFormatSite*>         fSites;
+
+    std::mutex                                  fDrainMutex;
+    std::string                                 fOutput;
+    EgLogTimeFormatter                          fTimeFormatter;
+    int                                         fBinaryFd = -1;     // 以下三项受 fDrainMutex 保护
+    uint32_t                                    fBinaryEpoch = 0;
+    size_t                                      fSitesWritten = 0;
+
+    std::mutex                                  fWakeMutex;
+    std::condition_variable                     fWakeCond;
+    std::atomic<bool>                           fWakeRequested {false};
+
+    std::atomic<bool>                           fRunning {true};
+    std::atomic<int>                            fOutputFd;
+    std::thread                                 fThread;
+};
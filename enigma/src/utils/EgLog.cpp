@@ -1,12 +1,13 @@
 #include "include/utils/EgLog.h"
 
-#include <time.h>
-#include <sys/time.h>
-#include <cstring>
-#include <sstream>
-#include <thread>
-#include <iostream>
+#include "include/core/EgAtom.h"
+
+#include "src/core/EgTHash.h"
+#include "src/utils/EgAsyncLogger.h"
+
 #include <stdarg.h>
+#include <cstdio>
+#include <mutex>
 
 /**
  * 可变参数函数，用于格式化输出调试信息。
@@ -27,3 +28,136 @@ void EgDebugf(const char* fmt, ...) {
     // 清理 args，释放其占用的资源
     va_end(args);
 }
+
+namespace {
+
+struct EgLogLevelTable {
+    std::mutex                                      fMutex;
+    EgLogLevel                                      fLevel = gVerbose_EgLogLevel;
+    // tag 驻留为 EgAtom，查表只比较指针，不再为每次查询构造 std::string
+    EgTHashMap<EgAtom, EgLogLevel>                  fTagLevels;
+};
+
+static EgLogLevelTable& level_table() {
+    // 有意泄漏：静态析构之后其他线程仍可能查询级别
+    static EgLogLevelTable* gTable = new EgLogLevelTable();
+    return *gTable;
+}
+
+}  // namespace
+
+std::atomic<uint32_t> EgLog::gLevelGeneration {1};
+
+EgLogLevel EgLog::LevelForTag(const char* tag) {
+    EgLogLevelTable& table = level_table();
+    std::lock_guard<std::mutex> lock(table.fMutex);
+    EgAtom atom;
+    // 没被驻留过的 tag 不可能单独设置过级别
+    if (!table.fTagLevels.empty() && EgAtom::Find(tag, &atom)) {
+        if (const EgLogLevel* level = table.fTagLevels.find(atom)) {
+            return *level;
+        }
+    }
+    return table.fLevel;
+}
+
+void EgLog::SetLevel(EgLogLevel level) {
+    EgLogLevelTable& table = level_table();
+    std::lock_guard<std::mutex> lock(table.fMutex);
+    table.fLevel = level;
+    gLevelGeneration.fetch_add(1, std::memory_order_release);
+}
+
+void EgLog::SetTagLevel(const char* tag, EgLogLevel level) {
+    EgLogLevelTable& table = level_table();
+    std::lock_guard<std::mutex> lock(table.fMutex);
+    table.fTagLevels.set(EgAtom::Make(tag), level);
+    gLevelGeneration.fetch_add(1, std::memory_order_release);
+}
+
+void EgLog::ClearTagLevels() {
+    EgLogLevelTable& table = level_table();
+    std::lock_guard<std::mutex> lock(table.fMutex);
+    table.fTagLevels.reset();
+    gLevelGeneration.fetch_add(1, std::memory_order_release);
+}
+
+void EgLog::Write(EgLogLevel level, const char* tag, const char* message, size_t length) {
+    EgAsyncLogger::Get().write(level, tag, message, length);
+}
+
+EgLogFormatSite::EgLogFormatSite(EgLogLevel level, const char* tag, const char* format,
+                                 const char* file, int line)
+    : fLevel(level)
+    , fTag(tag)
+    , fFormat(format)
+    , fFile(file)
+    , fLine(line)
+    , fId(EgAsyncLogger::Get().registerSite(this)) {
+}
+
+void EgLog::WriteBinary(const EgLogFormatSite& site, const uint8_t* args, size_t length) {
+    EgAsyncLogger::Get().writeBinary(site, args, length);
+}
+
+void EgLog::SetBinaryOutputFd(int fd) {
+    EgAsyncLogger::Get().setBinaryOutputFd(fd);
+}
+
+void EgLog::SetThreadName(const char* name) {
+    EgAsyncLogger::Get().setThreadName(name);
+}
+
+void EgLog::Flush() {
+    EgAsyncLogger::Get().flush();
+}
+
+void EgLog::SetOutputFd(int fd) {
+    EgAsyncLogger::Get().setOutputFd(fd);
+}
+
+namespace {
+
+/**
+ * @brief 写入固定缓冲区的 streambuf，写满后后续输出被丢弃
+ */
+class EgLogStreamBuf : public std::streambuf {
+public:
+    EgLogStreamBuf() { this->reset(); }
+
+    void reset() { this->setp(fBuffer, fBuffer + sizeof(fBuffer)); }
+
+    const char* data() const { return this->pbase(); }
+    size_t size() const { return (size_t)(this->pptr() - this->pbase()); }
+
+private:
+    char fBuffer[EgLogRing::kMaxMessageLength];
+};
+
+struct EgLogThreadStream {
+    EgLogStreamBuf  fBuf;
+    std::ostream    fStream {&fBuf};
+};
+
+static EgLogThreadStream& thread_stream() {
+    thread_local EgLogThreadStream stream;
+    return stream;
+}
+
+}  // namespace
+
+std::ostream& EgLog::BeginStream() {
+    EgLogThreadStream& stream = thread_stream();
+    stream.fBuf.reset();
+    stream.fStream.clear();
+    // 上一条日志可能改过格式（例如 std::hex），每条日志都从默认格式开始
+    stream.fStream.flags(std::ios_base::dec | std::ios_base::skipws);
+    stream.fStream.precision(6);
+    stream.fStream.fill(' ');
+    return stream.fStream;
+}
+
+void EgLog::EndStream(EgLogLevel level, const char* tag, std::ostream& stream) {
+    EgLogStreamBuf* buf = static_cast<EgLogStreamBuf*>(stream.rdbuf());
+    EgAsyncLogger::Get().write(level, tag, buf->data(), buf->size());
+}
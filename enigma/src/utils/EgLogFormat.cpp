@@ -0,0 +1,330 @@
+#include "src/utils/EgLogFormat.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <time.h>
+
+namespace {
+
+static char level_char(EgLogLevel level) {
+    static constexpr char gChars[] = {'V', 'D', 'I', 'W', 'E'};
+    return level <= gLastEnum_EgLogLevel ? gChars[level] : '?';
+}
+
+/**
+ * @brief 读取一个参数，类型不符或数据不足时返回 false
+ */
+struct ArgReader {
+    const uint8_t*  fCur;
+    const uint8_t*  fEnd;
+
+    bool next(EgLogArgs::Type* type, const uint8_t** data, uint32_t* size) {
+        if (fCur >= fEnd) {
+            return false;
+        }
+        *type = (EgLogArgs::Type)*fCur++;
+        if (*type == EgLogArgs::gString) {
+            if (fEnd - fCur < (ptrdiff_t)sizeof(uint32_t)) {
+                return false;
+            }
+            memcpy(size, fCur, sizeof(uint32_t));
+            fCur += sizeof(uint32_t);
+        } else {
+            *size = 8;
+        }
+        if (fEnd - fCur < (ptrdiff_t)*size) {
+            fCur = fEnd;
+            return false;
+        }
+        *data = fCur;
+        fCur += *size;
+        return true;
+    }
+
+    /**
+     * @brief 读取 * 宽度 / 精度对应的整数参数
+     */
+    bool nextInt(int* value) {
+        EgLogArgs::Type type;
+        const uint8_t* data;
+        uint32_t size;
+        if (!this->next(&type, &data, &size) || (type != EgLogArgs::gInt && type != EgLogArgs::gUInt)) {
+            return false;
+        }
+        int64_t bits;
+        memcpy(&bits, data, sizeof(bits));
+        // 宽度再大输出也会被截断，限制一下以免溢出 int
+        *value = (int)std::clamp<int64_t>(bits, -4096, 4096);
+        return true;
+    }
+};
+
+static void append_formatted(std::string* out, const char* spec, ...) __attribute__((format(printf, 2, 3)));
+
+static void append_formatted(std::string* out, const char* spec, ...) {
+    char buffer[256];
+    va_list args;
+    va_start(args, spec);
+    int length = vsnprintf(buffer, sizeof(buffer), spec, args);
+    va_end(args);
+    if (length > 0) {
+        out->append(buffer, std::min<size_t>((size_t)length, sizeof(buffer) - 1));
+    }
+}
+
+}  // namespace
+
+void EgLogFormatArgs(const char* format, const uint8_t* args, size_t length, std::string* out) {
+    ArgReader reader = {args, args + length};
+    const char* p = format;
+    while (*p) {
+        const char* percent = strchr(p, '%');
+        if (percent == nullptr) {
+            out->append(p);
+            return;
+        }
+        out->append(p, (size_t)(percent - p));
+        p = percent + 1;
+        if (*p == '%') {
+            out->push_back('%');
+            ++p;
+            continue;
+        }
+
+        // 拷贝标志、宽度和精度，丢弃长度修饰符，最后按参数的实际类型补上转换说明。
+        // 宽度或精度为 * 时从参数中取出对应的整数，直接写进 spec
+        char spec[48] = "%";
+        size_t specLength = 1;
+        bool starValid = true;
+        while (*p && strchr("-+ #0123456789.*", *p) && specLength < sizeof(spec) - 16) {
+            if (*p != '*') {
+                spec[specLength++] = *p++;
+                continue;
+            }
+            ++p;
+            int value;
+            if (!reader.nextInt(&value)) {
+                starValid = false;
+                continue;
+            }
+            if (value < 0 && spec[specLength - 1] == '.') {
+                // 负的精度等同于没有指定精度
+                --specLength;
+                continue;
+            }
+            specLength += (size_t)snprintf(spec + specLength, sizeof(spec) - specLength, "%d", value);
+        }
+        while (*p && strchr("hlLqjzt", *p)) {
+            ++p;
+        }
+        const char conversion = *p ? *p++ : 's';
+
+        EgLogArgs::Type type;
+        const uint8_t* data;
+        uint32_t size;
+        if (!reader.next(&type, &data, &size) || !starValid) {
+            out->append("<?>");
+            continue;
+        }
+
+        switch (type) {
+            case EgLogArgs::gInt:
+            case EgLogArgs::gUInt:
+            case EgLogArgs::gPointer: {
+                uint64_t bits;
+                memcpy(&bits, data, sizeof(bits));
+                if (conversion == 'c') {
+                    strcpy(spec + specLength, "c");
+                    append_formatted(out, spec, (int)bits);
+                } else if (strchr("fFeEgGaA", conversion)) {
+                    spec[specLength] = conversion;
+                    spec[specLength + 1] = '\0';
+                    append_formatted(out, spec, type == EgLogArgs::gInt ? (double)(int64_t)bits : (double)bits);
+                } else if (conversion == 'p' || type == EgLogArgs::gPointer) {
+                    strcpy(spec + specLength, "#" PRIx64);
+                    append_formatted(out, spec, bits);
+                } else if (strchr("xXo", conversion)) {
+                    strcpy(spec + specLength, conversion == 'x' ? PRIx64 : conversion == 'X' ? PRIX64 : PRIo64);
+                    append_formatted(out, spec, bits);
+                } else if (type == EgLogArgs::gInt && conversion != 'u') {
+                    strcpy(spec + specLength, PRId64);
+                    append_formatted(out, spec, (int64_t)bits);
+                } else {
+                    strcpy(spec + specLength, PRIu64);
+                    append_formatted(out, spec, bits);
+                }
+                break;
+            }
+            case EgLogArgs::gDouble: {
+                double value;
+                memcpy(&value, data, sizeof(value));
+                spec[specLength] = strchr("fFeEgGaA", conversion) ? conversion : 'g';
+                spec[specLength + 1] = '\0';
+                append_formatted(out, spec, value);
+                break;
+            }
+            case EgLogArgs::gString: {
+                if (specLength == 1) {
+                    out->append(reinterpret_cast<const char*>(data), size);
+                } else {
+                    std::string str(reinterpret_cast<const char*>(data), size);
+                    strcpy(spec + specLength, "s");
+                    append_formatted(out, spec, str.c_str());
+                }
+                break;
+            }
+            default:
+                out->append("<?>");
+                return;
+        }
+    }
+}
+
+void EgLogTimeFormatter::format(uint64_t timeNs, char out[kLength]) {
+    const int64_t second = (int64_t)(timeNs / 1000000000ull);
+    if (second != fSecond) {
+        time_t seconds = (time_t)second;
+        struct tm tm;
+        localtime_r(&seconds, &tm);
+        char date[64] = {};
+        strftime(date, sizeof(date), "%Y-%m-%d %H:%M:%S", &tm);
+        memcpy(fDate, date, sizeof(fDate));
+        fSecond = second;
+    }
+
+    const unsigned millis = (unsigned)(timeNs / 1000000ull % 1000);
+    memcpy(out, fDate, sizeof(fDate) - 1);
+    out[19] = '.';
+    out[20] = (char)('0' + millis / 100);
+    out[21] = (char)('0' + millis / 10 % 10);
+    out[22] = (char)('0' + millis % 10);
+}
+
+void EgLogFormatPrefix(EgLogTimeFormatter* time, uint64_t timeNs, const char* threadName,
+                       EgLogLevel level, const char* tag, std::string* out) {
+    char prefix[128];
+    time->format(timeNs, prefix);
+    size_t length = EgLogTimeFormatter::kLength;
+    length += snprintf(prefix + length, sizeof(prefix) - length, " %s %c/%-10.10s: ",
+                       threadName, level_char(level), tag);
+    out->append(prefix, std::min(length, sizeof(prefix) - 1));
+}
+
+////////////////////////////////////////////////////////
+
+namespace {
+
+template <typename T>
+static void append_pod(std::string* out, const T& value) {
+    out->append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+static void append_string(std::string* out, const char* str, uint32_t length) {
+    append_pod(out, length);
+    out->append(str, length);
+}
+
+static void append_string(std::string* out, const char* str) {
+    append_string(out, str, (uint32_t)strlen(str));
+}
+
+}  // namespace
+
+void EgBinaryLog::AppendSite(std::string* out, const EgLogFormatSite& site) {
+    out->push_back(gSite);
+    append_pod(out, site.fId);
+    append_pod(out, (uint8_t)site.fLevel);
+    append_pod(out, (uint32_t)site.fLine);
+    append_string(out, site.fTag);
+    append_string(out, site.fFormat);
+    append_string(out, site.fFile);
+}
+
+void EgBinaryLog::AppendThread(std::string* out, uint32_t tid, const char* name) {
+    out->push_back(gThread);
+    append_pod(out, tid);
+    append_string(out, name);
+}
+
+void EgBinaryLog::AppendEvent(std::string* out, uint32_t id, uint32_t tid, uint64_t timeNs,
+                              const char* args, uint32_t length) {
+    out->push_back(gEvent);
+    append_pod(out, id);
+    append_pod(out, tid);
+    append_pod(out, timeNs);
+    append_string(out, args, length);
+}
+
+void EgBinaryLog::AppendText(std::string* out, EgLogLevel level, uint32_t tid, uint64_t timeNs,
+                             const char* tag, const char* text, uint32_t length) {
+    out->push_back(gText);
+    append_pod(out, (uint8_t)level);
+    append_pod(out, tid);
+    append_pod(out, timeNs);
+    append_string(out, tag);
+    append_string(out, text, length);
+}
+
+template <typename T>
+bool EgBinaryLog::Reader::read(T* value) {
+    if (fEnd - fCur < (ptrdiff_t)sizeof(T)) {
+        return false;
+    }
+    memcpy(value, fCur, sizeof(T));
+    fCur += sizeof(T);
+    return true;
+}
+
+bool EgBinaryLog::Reader::readString(std::string* value) {
+    uint32_t length;
+    if (!this->read(&length) || fEnd - fCur < (ptrdiff_t)length) {
+        return false;
+    }
+    value->assign(reinterpret_cast<const char*>(fCur), length);
+    fCur += length;
+    return true;
+}
+
+bool EgBinaryLog::Reader::readHeader() {
+    if (fEnd - fCur < (ptrdiff_t)sizeof(kMagic) || memcmp(fCur, kMagic, sizeof(kMagic)) != 0) {
+        return false;
+    }
+    fCur += sizeof(kMagic);
+    return true;
+}
+
+bool EgBinaryLog::Reader::next(Record* record) {
+    uint8_t type;
+    if (!this->read(&type)) {
+        return false;
+    }
+    record->fType = (RecordType)type;
+    uint8_t level = 0;
+    switch (type) {
+        case gSite:
+            if (!this->read(&record->fId) || !this->read(&level) || !this->read(&record->fLine) ||
+                !this->readString(&record->fTag) || !this->readString(&record->fText) ||
+                !this->readString(&record->fFile)) {
+                return false;
+            }
+            record->fLevel = (EgLogLevel)level;
+            return true;
+        case gThread:
+            return this->read(&record->fTid) && this->readString(&record->fText);
+        case gEvent:
+            return this->read(&record->fId) && this->read(&record->fTid) &&
+                   this->read(&record->fTimeNs) && this->readString(&record->fArgs);
+        case gText:
+            if (!this->read(&level) || !this->read(&record->fTid) || !this->read(&record->fTimeNs) ||
+                !this->readString(&record->fTag) || !this->readString(&record->fText)) {
+                return false;
+            }
+            record->fLevel = (EgLogLevel)level;
+            return true;
+        default:
+            return false;
+    }
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "include/private/base/EgAPI.h"
+#include "include/utils/EgLog.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief 按 printf 风格的 format 展开 EgLogArgs 编码的参数，追加到 out
+ *
+ * 长度修饰符（l、ll、z 等）被忽略，整数一律按 64 位输出；参数缺失或类型不符时输出占位符。
+ */
+EG_API void EgLogFormatArgs(const char* format, const uint8_t* args, size_t length, std::string* out);
+
+/**
+ * @brief 把时间戳格式化为 "YYYY-MM-DD HH:MM:SS.mmm"
+ *
+ * 日期和时分秒部分只在秒数变化时用 localtime_r + strftime 重新生成，同一秒内的日志只拼接毫秒。
+ * 不是线程安全的，每个格式化线程持有自己的实例。
+ */
+class EG_API EgLogTimeFormatter {
+public:
+    static constexpr size_t kLength = 23;
+
+    /**
+     * @brief 写入 kLength 个字符，不含结尾的 '\0'
+     */
+    void format(uint64_t timeNs, char out[kLength]);
+
+private:
+    int64_t     fSecond = -1;
+    char        fDate[20];      // "YYYY-MM-DD HH:MM:SS"
+};
+
+/**
+ * @brief 追加文本日志的行前缀："YYYY-MM-DD HH:MM:SS.mmm 线程名 L/tag       : "
+ */
+EG_API void EgLogFormatPrefix(EgLogTimeFormatter* time, uint64_t timeNs, const char* threadName,
+                              EgLogLevel level, const char* tag, std::string* out);
+
+/**
+ * 二进制日志文件格式（主机字节序）
+ *
+ * 文件以 8 字节的 kMagic 开头，之后是若干条记录，每条以 1 字节的记录类型开头：
+ * - gSite   : u32 id, u8 level, u32 line, str tag, str format, str file
+ * - gThread : u32 tid, str name
+ * - gEvent  : u32 id, u32 tid, u64 timeNs, u32 argsLength, args
+ * - gText   : u8 level, u32 tid, u64 timeNs, str tag, str text
+ * 其中 str 为 u32 长度 + 字节。gSite / gThread 总是出现在引用它们的记录之前。
+ */
+namespace EgBinaryLog {
+
+    static constexpr char kMagic[8] = {'E', 'G', 'B', 'L', 'O', 'G', '0', '1'};
+
+    enum RecordType : uint8_t {
+        gSite   = 'F',
+        gThread = 'N',
+        gEvent  = 'E',
+        gText   = 'T',
+    };
+
+    EG_API void AppendSite(std::string* out, const EgLogFormatSite& site);
+
+    EG_API void AppendThread(std::string* out, uint32_t tid, const char* name);
+
+    EG_API void AppendEvent(std::string* out, uint32_t id, uint32_t tid, uint64_t timeNs,
+                     const char* args, uint32_t length);
+
+    EG_API void AppendText(std::string* out, EgLogLevel level, uint32_t tid, uint64_t timeNs,
+                    const char* tag, const char* text, uint32_t length);
+
+    /**
+     * @brief 顺序读取二进制日志中的记录
+     */
+    class EG_API Reader {
+    public:
+        struct Record {
+            RecordType      fType;
+            uint32_t        fId         = 0;
+            uint32_t        fTid        = 0;
+            uint32_t        fLine       = 0;
+            uint64_t        fTimeNs     = 0;
+            EgLogLevel      fLevel      = gInfo_EgLogLevel;
+            std::string     fTag;
+            std::string     fText;      // gSite 的格式串、gThread 的线程名、gText 的文本
+            std::string     fFile;
+            std::string     fArgs;      // gEvent 的参数字节
+        };
+
+        Reader(const uint8_t* data, size_t size) : fCur(data), fEnd(data + size) {}
+
+        /**
+         * @brief 检查并跳过文件头
+         */
+        bool readHeader();
+
+        /**
+         * @brief 读取下一条记录
+         * @return 数据结束或记录截断时返回 false
+         */
+        bool next(Record* record);
+
+    private:
+        template <typename T>
+        bool read(T* value);
+        bool readString(std::string* value);
+
+        const uint8_t*  fCur;
+        const uint8_t*  fEnd;
+    };
+
+};
@@ -0,0 +1,197 @@
+#include "include/utils/EgTrace.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+struct TraceEvent {
+    const char*     fCategory;
+    const char*     fName;
+    const char*     fArgName;
+    int64_t         fArgValue;
+    uint64_t        fStartNs;
+    uint64_t        fDurationNs;
+};
+
+/**
+ * @brief 单个线程的事件缓冲区，只有所属线程写入
+ *
+ * 代数和事件数打包在同一个原子变量 fState 里（高 32 位代数，低 32 位个数），以 release 发布，
+ * Dump 以 acquire 读取，看到的代数和个数总是同一次发布的，只读取已发布的事件。写满后丢弃并计数。
+ */
+struct TraceBuffer {
+    static constexpr uint32_t kCapacity = 32 * 1024;
+
+    TraceBuffer() : fEvents(new TraceEvent[kCapacity]) {}
+
+    std::unique_ptr<TraceEvent[]>   fEvents;
+    std::atomic<uint64_t>           fState {0};
+    std::atomic<uint64_t>           fDropped {0};
+    int                             fTid = 0;
+    char                            fThreadName[16] = {};
+};
+
+struct TraceRegistry {
+    std::mutex                                  fMutex;
+    std::vector<std::shared_ptr<TraceBuffer>>   fBuffers;
+    std::atomic<uint32_t>                       fGeneration {0};
+};
+
+static inline uint64_t pack_state(uint32_t generation, uint32_t count) {
+    return ((uint64_t)generation << 32) | count;
+}
+
+static TraceRegistry& registry() {
+    // 有意泄漏：线程可能在静态析构之后仍在记录事件
+    static TraceRegistry* gRegistry = new TraceRegistry();
+    return *gRegistry;
+}
+
+/**
+ * @brief 本线程的缓冲区，首次记录事件时创建；线程退出后缓冲区仍由注册表持有，事件不会丢失
+ */
+static TraceBuffer* thread_buffer() {
+    thread_local std::shared_ptr<TraceBuffer> buffer;
+    if (!buffer) {
+        buffer = std::make_shared<TraceBuffer>();
+        buffer->fTid = (int)syscall(SYS_gettid);
+        pthread_getname_np(pthread_self(), buffer->fThreadName, sizeof(buffer->fThreadName));
+
+        TraceRegistry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.fMutex);
+        reg.fBuffers.push_back(buffer);
+    }
+    return buffer.get();
+}
+
+static void write_json_string(FILE* file, const char* str) {
+    fputc('"', file);
+    for (; *str; ++str) {
+        const unsigned char c = (unsigned char)*str;
+        if (c == '"' || c == '\\') {
+            fputc('\\', file);
+            fputc(c, file);
+        } else if (c < 0x20) {
+            fprintf(file, "\\u%04x", c);
+        } else {
+            fputc(c, file);
+        }
+    }
+    fputc('"', file);
+}
+
+}  // namespace
+
+std::atomic<bool> EgTrace::gEnabled {false};
+
+uint64_t EgTrace::NowNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+void EgTrace::Start() {
+    TraceRegistry& reg = registry();
+    {
+        // 只剩注册表持有的缓冲区属于已退出的线程，上一轮的数据不再需要
+        std::lock_guard<std::mutex> lock(reg.fMutex);
+        reg.fBuffers.erase(std::remove_if(reg.fBuffers.begin(), reg.fBuffers.end(),
+                                          [](const std::shared_ptr<TraceBuffer>& buffer) {
+                                              return buffer.use_count() == 1;
+                                          }), reg.fBuffers.end());
+    }
+    // 各线程在下一次记录时发现代数变化，自行清空缓冲区
+    reg.fGeneration.fetch_add(1, std::memory_order_relaxed);
+    gEnabled.store(true, std::memory_order_release);
+}
+
+void EgTrace::Stop() {
+    gEnabled.store(false, std::memory_order_release);
+}
+
+void EgTrace::AddCompleteEvent(const char* category, const char* name, uint64_t startNs, uint64_t endNs,
+                               const char* argName, int64_t argValue) {
+    TraceBuffer* buffer = thread_buffer();
+    const uint64_t state = buffer->fState.load(std::memory_order_relaxed);
+    uint32_t count = (uint32_t)state;
+    const uint32_t generation = registry().fGeneration.load(std::memory_order_relaxed);
+    if ((uint32_t)(state >> 32) != generation) {
+        buffer->fDropped.store(0, std::memory_order_relaxed);
+        count = 0;
+    }
+    if (count >= TraceBuffer::kCapacity) {
+        buffer->fDropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    buffer->fEvents[count] = {category, name, argName, argValue, startNs, endNs - startNs};
+    buffer->fState.store(pack_state(generation, count + 1), std::memory_order_release);
+}
+
+bool EgTrace::Dump(const char* path) {
+    FILE* file = fopen(path, "w");
+    if (file == nullptr) {
+        return false;
+    }
+
+    std::vector<std::shared_ptr<TraceBuffer>> buffers;
+    TraceRegistry& reg = registry();
+    const uint32_t generation = reg.fGeneration.load(std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(reg.fMutex);
+        buffers = reg.fBuffers;
+    }
+
+    const int pid = (int)getpid();
+    bool first = true;
+    auto separator = [&] {
+        fputs(first ? "\n" : ",\n", file);
+        first = false;
+    };
+
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", file);
+    for (const std::shared_ptr<TraceBuffer>& buffer : buffers) {
+        // 本轮追踪中没有记录过事件的线程，缓冲区里是上一轮的数据
+        const uint64_t state = buffer->fState.load(std::memory_order_acquire);
+        if ((uint32_t)(state >> 32) != generation) {
+            continue;
+        }
+        const uint32_t count = (uint32_t)state;
+
+        separator();
+        fprintf(file, "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":",
+                pid, buffer->fTid);
+        write_json_string(file, buffer->fThreadName);
+        fputs("}}", file);
+
+        for (uint32_t i = 0; i < count; ++i) {
+            const TraceEvent& event = buffer->fEvents[i];
+            separator();
+            fputs("{\"ph\":\"X\",\"cat\":", file);
+            write_json_string(file, event.fCategory);
+            fputs(",\"name\":", file);
+            write_json_string(file, event.fName);
+            fprintf(file, ",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f", pid, buffer->fTid,
+                    event.fStartNs / 1000.0, event.fDurationNs / 1000.0);
+            if (event.fArgName) {
+                fputs(",\"args\":{", file);
+                write_json_string(file, event.fArgName);
+                fprintf(file, ":%lld}", (long long)event.fArgValue);
+            }
+            fputc('}', file);
+        }
+        if (uint64_t dropped = buffer->fDropped.load(std::memory_order_relaxed)) {
+            fprintf(stderr, "EgTrace: thread %d dropped %llu events\n", buffer->fTid, (unsigned long long)dropped);
+        }
+    }
+    fputs("\n]}\n", file);
+    return fclose(file) == 0;
+}
@@ -0,0 +1,56 @@
+#include "include/private/base/EgAssert.h"
+#include "src/base/EgUTF.h"
+
+#include <cstring>
+
+/**
+ * @brief 长度查询（dst 为 nullptr）必须与实际写入的长度一致，非法输入两种模式都返回 -1
+ */
+static void check_utf8_lengths(const char* utf8, size_t length) {
+    uint16_t utf16[256];
+    EgUnichar utf32[256];
+    EgAssertRelease(length <= 256);
+
+    const int query16 = EgUTF::UTF8ToUTF16(nullptr, 0, utf8, length);
+    const int written16 = EgUTF::UTF8ToUTF16(utf16, 256, utf8, length);
+    EgAssertRelease(query16 == written16);
+
+    const int query32 = EgUTF::UTF8ToUTF32(nullptr, 0, utf8, length);
+    const int written32 = EgUTF::UTF8ToUTF32(utf32, 256, utf8, length);
+    EgAssertRelease(query32 == written32);
+    EgAssertRelease(EgUTF::CountUTF8(utf8, length) == query32);
+
+    // 转出的 UTF-16 一定能再转回来，不会含有孤立的代理项
+    if (written16 > 0) {
+        EgAssertRelease(EgUTF::UTF16ToUTF8(nullptr, 0, utf16, written16) == (int)length);
+    }
+}
+
+void EgUTFTest() {
+    static const char* const gSequences[] = {
+        "\xC3\xA9",             // U+00E9
+        "\xE0\xA0\x80",         // U+0800
+        "\xED\x9F\xBF",         // U+D7FF
+        "\xF0\x90\x80\x80",     // U+10000
+        "\xF4\x8F\xBF\xBF",     // U+10FFFF
+        "\xF0\x80\x80\x80",     // 过长编码
+        "\xE0\x9F\xBF",         // 过长编码
+        "\xED\xA0\x80",         // 代理项 U+D800
+        "\xF4\x90\x80\x80",     // U+110000
+    };
+    // 前后补 ASCII，同时覆盖逐序列和 16 字节一块的路径
+    for (const char* sequence : gSequences) {
+        char buffer[64];
+        for (size_t pad = 0; pad <= 20; pad += 20) {
+            const size_t length = strlen(sequence);
+            memset(buffer, 'a', pad);
+            memcpy(buffer + pad, sequence, length);
+            memset(buffer + pad + length, 'b', pad);
+            check_utf8_lengths(buffer, pad * 2 + length);
+        }
+    }
+
+    uint16_t utf16[2];
+    EgAssertRelease(EgUTF::UTF8ToUTF16(utf16, 2, "\xF0\x80\x80\x80", 4) == -1);
+    EgAssertRelease(EgUTF::UTF8ToUTF16(utf16, 2, "\xF0\x90\x80\x80", 4) == 2);
+}
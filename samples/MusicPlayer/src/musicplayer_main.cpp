@@ -5,7 +5,9 @@
 #include <GLFW/glfw3.h>
 
 #include <vulkan/vulkan.h>
+#include <chrono>
 #include <iostream>
+#include <thread>
 #include "gelf.h"
 
 #include "include/core/EgPoint.h"
@@ -0,0 +1,99 @@
+/**
+ * eg_logdecode：把 EgLog::SetBinaryOutputFd 写出的二进制日志还原成与文本模式相同格式的文本
+ *
+ * 用法：eg_logdecode <log.bin> [output.txt]，省略输出文件时写到标准输出。
+ */
+#include "src/utils/EgLogFormat.h"
+
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+struct Site {
+    EgLogLevel      fLevel;
+    std::string     fTag;
+    std::string     fFormat;
+};
+
+static bool read_file(const char* path, std::vector<uint8_t>* data) {
+    FILE* file = fopen(path, "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    uint8_t buffer[64 * 1024];
+    size_t count;
+    while ((count = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        data->insert(data->end(), buffer, buffer + count);
+    }
+    fclose(file);
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <log.bin> [output.txt]\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<uint8_t> data;
+    if (!read_file(argv[1], &data)) {
+        fprintf(stderr, "eg_logdecode: cannot read %s\n", argv[1]);
+        return 1;
+    }
+    FILE* out = argc > 2 ? fopen(argv[2], "w") : stdout;
+    if (out == nullptr) {
+        fprintf(stderr, "eg_logdecode: cannot write %s\n", argv[2]);
+        return 1;
+    }
+
+    EgBinaryLog::Reader reader(data.data(), data.size());
+    if (!reader.readHeader()) {
+        fprintf(stderr, "eg_logdecode: %s is not a binary log\n", argv[1]);
+        return 1;
+    }
+
+    std::unordered_map<uint32_t, Site> sites;
+    std::unordered_map<uint32_t, std::string> threads;
+    EgLogTimeFormatter time;
+    EgBinaryLog::Reader::Record record;
+    std::string line;
+    while (reader.next(&record)) {
+        line.clear();
+        switch (record.fType) {
+            case EgBinaryLog::gSite:
+                sites[record.fId] = {record.fLevel, record.fTag, record.fText};
+                continue;
+            case EgBinaryLog::gThread:
+                threads[record.fTid] = record.fText;
+                continue;
+            case EgBinaryLog::gEvent: {
+                auto site = sites.find(record.fId);
+                if (site == sites.end()) {
+                    fprintf(stderr, "eg_logdecode: unknown format id %u\n", record.fId);
+                    continue;
+                }
+                EgLogFormatPrefix(&time, record.fTimeNs, threads[record.fTid].c_str(), site->second.fLevel,
+                                  site->second.fTag.c_str(), &line);
+                EgLogFormatArgs(site->second.fFormat.c_str(),
+                                reinterpret_cast<const uint8_t*>(record.fArgs.data()), record.fArgs.size(), &line);
+                break;
+            }
+            case EgBinaryLog::gText:
+                EgLogFormatPrefix(&time, record.fTimeNs, threads[record.fTid].c_str(), record.fLevel,
+                                  record.fTag.c_str(), &line);
+                line.append(record.fText);
+                break;
+        }
+        line.push_back('\n');
+        fwrite(line.data(), 1, line.size(), out);
+    }
+    if (out != stdout) {
+        fclose(out);
+    }
+    return 0;
+}